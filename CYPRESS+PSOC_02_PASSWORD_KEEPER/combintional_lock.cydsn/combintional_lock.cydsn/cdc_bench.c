@@ -0,0 +1,116 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "cdc_bench.h"
+#include "cdc_rx.h"
+#include "cdc_tx.h"
+#include "ep_copy.h"
+#include "lcd_screen.h"
+#include "tick.h"
+
+#if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+    #define CDC_BENCH_MODE  "DMA auto"
+#elif (USBUART_EP_MANAGEMENT_DMA_MANUAL)
+    #define CDC_BENCH_MODE  "DMA manual"
+#else
+    #define CDC_BENCH_MODE  "manual"
+#endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+static const lcd_screen_t screenBench = {{ "IN %s", "%u KB/s" }};
+
+#if (EP_COPY_BENCH_ENABLE)
+    static const lcd_screen_t screenCopy = {{ "%s %uB", "in %u out %u" }};
+    static char8 const * const copyName[EP_COPY_METHODS] = { "byte", "unrolled", "word", "DMA" };
+
+    // Cycles per endpoint copy, one method and size per window
+    static void CdcBench_ShowCopy(void)
+    {
+        ep_copy_bench_t result;
+        uint8 size;
+        uint8 method;
+
+        EpCopy_Bench(USBUART_cdcDataInEp[USBUART_COM_PORT1], &result);
+        for (size = 0u; size < EP_COPY_BENCH_SIZES; size++)
+        {
+            for (method = 0u; method < (uint8)EP_COPY_METHODS; method++)
+            {
+                (void)LcdScreen_Show(&screenCopy, copyName[method], result.length[size],
+                    (uint16)result.inCycles[size][method], (uint16)result.outCycles[size][method]);
+                CyDelay(CDC_BENCH_WINDOW_MS);
+            }
+        }
+    }
+#endif /* EP_COPY_BENCH_ENABLE */
+
+void CdcBench_Run(void)
+{
+    static uint8 pattern[CDC_TX_PACKET_SIZE];
+    uint8 drain[CDC_RX_PACKET_SIZE];
+    cdc_tx_stats_t stats;
+    uint32 windowMs;
+    uint32 windowBytes = 0u;
+    uint32 nowMs;
+    uint8 i;
+
+    for (i = 0u; i < CDC_TX_PACKET_SIZE; i++)
+    {
+        pattern[i] = (uint8)('0' + (i % 10u));
+    }
+    EpCopy_Init();
+    CdcRx_Init();
+    CdcTx_Init();
+    (void)LcdScreen_Show(&screenBench, CDC_BENCH_MODE, 0u);
+    windowMs = Tick_GetMs();
+
+    for (;;)
+    {
+        nowMs = Tick_GetMs();
+
+        if(0u != USBUART_IsConfigurationChanged())
+        {
+            if(0u != USBUART_GetConfiguration())
+            {
+                USBUART_CDC_Init();
+                #if (EP_COPY_BENCH_ENABLE)
+                    CdcBench_ShowCopy();
+                #endif /* EP_COPY_BENCH_ENABLE */
+                CdcRx_Start();
+                CdcTx_Init();
+                windowBytes = 0u;
+            }
+        }
+
+        if(0u != USBUART_GetConfiguration())
+        {
+            (void)CdcRx_Service();
+            (void)CdcRx_Read(drain, sizeof(drain));
+
+            // keep whole packets waiting so the endpoint never runs dry
+            while (CdcTx_Free() >= CDC_TX_PACKET_SIZE)
+            {
+                (void)CdcTx_Write(pattern, CDC_TX_PACKET_SIZE);
+            }
+            (void)CdcTx_Service(nowMs);
+        }
+
+        if ((uint32)(nowMs - windowMs) >= CDC_BENCH_WINDOW_MS)
+        {
+            CdcTx_GetStats(&stats);
+            (void)LcdScreen_Show(&screenBench, CDC_BENCH_MODE,
+                (uint16)(((stats.bytes - windowBytes) * 1000u) / ((uint32)(nowMs - windowMs) * 1024u)));
+            windowBytes = stats.bytes;
+            windowMs = nowMs;
+        }
+    }
+}
+
+/* [] END OF FILE */
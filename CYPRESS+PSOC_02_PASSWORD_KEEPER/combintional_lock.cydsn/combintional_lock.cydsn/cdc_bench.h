@@ -0,0 +1,48 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef CDC_BENCH_H
+#define CDC_BENCH_H
+
+#include "cytypes.h"
+
+/*
+ * CDC IN throughput benchmark. Built with CDC_BENCH_ENABLE set to 1 (e.g.
+ * in Build Settings > Compiler > Preprocessor Definitions), main.c runs
+ * CdcBench_Run() instead of the lock. It keeps the IN endpoint loaded with
+ * full packets through cdc_tx.c and every CDC_BENCH_WINDOW_MS shows the
+ * endpoint mode and the KB/s of the last window on the LCD; whatever the
+ * host writes is read and dropped. On the host, read the port
+ * continuously, e.g. cat /dev/ttyACM0 > /dev/null.
+ *
+ * To compare the modes on one board, change Endpoint Buffer Management in
+ * the USBUART's Configure dialog (Descriptor Root) between Manual, DMA
+ * with Manual Buffer Management and DMA with Automatic Buffer Management,
+ * regenerate, and flash each build. Creator adds the endpoint DMA channels
+ * for the DMA modes; USBUART_EP_MM in USBUART.h shows which one a build
+ * has.
+ *
+ * With EP_COPY_BENCH_ENABLE set as well, each configuration first runs
+ * EpCopy_Bench() on the IN endpoint and shows the cycles of every copy
+ * method for 8, 32 and 64 bytes, one per window, before streaming starts.
+ */
+
+#ifndef CDC_BENCH_ENABLE
+    #define CDC_BENCH_ENABLE    (0u)
+#endif /* CDC_BENCH_ENABLE */
+
+#define CDC_BENCH_WINDOW_MS     (1000u)
+
+// After USBUART_Start(), LcdFb_Init() and Tick_Start(); never returns.
+void CdcBench_Run(void);
+
+#endif /* CDC_BENCH_H */
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "project.h"
+#include "cdc_rx.h"
+#include "ep_copy.h"
+
+#define CDC_RX_MASK     (CDC_RX_RING_SIZE - 1u)
+#define CDC_RX_OUT_EP   (USBUART_cdcDataOutEp[USBUART_COM_PORT1])
+
+static cdc_rx_stats_t stats;
+
+#if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+    // the endpoint DMA writes each OUT packet here as it arrives; it is
+    // read in place and the endpoint re-armed once all of it is released
+    static uint8 landing[CDC_RX_PACKET_SIZE];
+    static uint16 landCount = 0u;       // bytes of the packet in landing
+    static uint16 landTaken = 0u;       // of them already released
+#else
+    static uint8 ring[CDC_RX_RING_SIZE];
+    static volatile uint16 head = 0u;   // free running, written by the producer
+    static volatile uint16 tail = 0u;   // free running, written by the consumer
+    static uint8 bounce[CDC_RX_PACKET_SIZE];
+#endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+void CdcRx_Init(void)
+{
+    #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+        landCount = 0u;
+        landTaken = 0u;
+    #else
+        head = 0u;
+        tail = 0u;
+    #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+    (void)memset(&stats, 0, sizeof(stats));
+}
+
+void CdcRx_Start(void)
+{
+    #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+        landCount = 0u;
+        landTaken = 0u;
+        (void)USBUART_ReadOutEP(CDC_RX_OUT_EP, landing, CDC_RX_PACKET_SIZE);
+    #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+}
+
+#if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+
+uint16 CdcRx_Service(void)
+{
+    uint16 count;
+
+    // the last packet is still being read, the host waits for the re-arm
+    if (0u != landCount)
+    {
+        return 0u;
+    }
+    if (0u == USBUART_DataIsReady())
+    {
+        return 0u;
+    }
+
+    count = USBUART_GetCount();
+    if (0u == count)
+    {
+        USBUART_EnableOutEP(CDC_RX_OUT_EP);
+        return 0u;
+    }
+    landCount = count;
+    landTaken = 0u;
+
+    stats.packets++;
+    stats.bytes += count;
+    if (count > stats.highWater)
+    {
+        stats.highWater = count;
+    }
+    return count;
+}
+
+uint16 CdcRx_Count(void)
+{
+    return (uint16)(landCount - landTaken);
+}
+
+const uint8 *CdcRx_Borrow(uint16 *length)
+{
+    *length = (uint16)(landCount - landTaken);
+    return (0u != *length) ? &landing[landTaken] : NULL;
+}
+
+void CdcRx_Release(uint16 count)
+{
+    landTaken += count;
+    if (landTaken >= landCount)
+    {
+        landCount = 0u;
+        landTaken = 0u;
+        USBUART_EnableOutEP(CDC_RX_OUT_EP);
+    }
+}
+
+#else
+
+uint16 CdcRx_Service(void)
+{
+    uint16 count;
+    uint16 used;
+    uint16 at;
+    uint16 first;
+
+    if (0u == USBUART_DataIsReady())
+    {
+        return 0u;
+    }
+
+    count = USBUART_GetCount();
+    used = (uint16)(head - tail);
+    if (count > (CDC_RX_RING_SIZE - used))
+    {
+        // leave it in the endpoint, the host retries until there is room
+        stats.stalls++;
+        return 0u;
+    }
+
+    at = head & CDC_RX_MASK;
+    first = CDC_RX_RING_SIZE - at;
+    if (count <= first)
+    {
+        count = EpCopy_ReadOutEP(CDC_RX_OUT_EP, &ring[at], count);
+    }
+    else
+    {
+        count = EpCopy_ReadOutEP(CDC_RX_OUT_EP, bounce, count);
+        (void)memcpy(&ring[at], bounce, first);
+        (void)memcpy(ring, &bounce[first], (size_t)count - first);
+    }
+
+    // publish only after the bytes are in place
+    head = (uint16)(head + count);
+
+    stats.packets++;
+    stats.bytes += count;
+    used += count;
+    if (used > stats.highWater)
+    {
+        stats.highWater = used;
+    }
+    return count;
+}
+
+uint16 CdcRx_Count(void)
+{
+    return (uint16)(head - tail);
+}
+
+const uint8 *CdcRx_Borrow(uint16 *length)
+{
+    uint16 count = (uint16)(head - tail);
+    uint16 at = tail & CDC_RX_MASK;
+
+    // only up to the end of the ring, the rest comes with the next borrow
+    if (count > (CDC_RX_RING_SIZE - at))
+    {
+        count = CDC_RX_RING_SIZE - at;
+    }
+    *length = count;
+    return (0u != count) ? &ring[at] : NULL;
+}
+
+void CdcRx_Release(uint16 count)
+{
+    tail = (uint16)(tail + count);
+}
+
+#endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+uint16 CdcRx_Read(uint8 *data, uint16 size)
+{
+    const uint8 *run;
+    uint16 count;
+    uint16 done = 0u;
+
+    while (done < size)
+    {
+        run = CdcRx_Borrow(&count);
+        if (NULL == run)
+        {
+            break;
+        }
+        if (count > (size - done))
+        {
+            count = size - done;
+        }
+        (void)memcpy(&data[done], run, count);
+        CdcRx_Release(count);
+        done += count;
+    }
+    return done;
+}
+
+void CdcRx_GetStats(cdc_rx_stats_t *copy)
+{
+    *copy = stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef CDC_RX_H
+#define CDC_RX_H
+
+#include "cytypes.h"
+
+/*
+ * Bulk receive path of the USBUART CDC port. CdcRx_Service() takes a whole
+ * OUT packet from the endpoint at once, straight into a power-of-two ring
+ * when it fits without wrapping, through one packet-sized bounce buffer when
+ * it does not. USBUART_GetChar() reads one byte and re-arms the endpoint, so
+ * the rest of a pasted packet was lost; here every byte is kept.
+ *
+ * A packet is only taken once the ring has room for all of it. Until then
+ * it stays in the endpoint and the host is NAKed, so a slow consumer
+ * throttles the host instead of losing data.
+ *
+ * In manual endpoint mode the packet is read with EpCopy_ReadOutEP(), the
+ * same as USBUART_GetData() with a faster copy out of the endpoint.
+ *
+ * The ring has a single producer (CdcRx_Service) and a single consumer
+ * (CdcRx_Read, or CdcRx_Borrow and CdcRx_Release) and needs no locking as
+ * long as each side stays in one context.
+ *
+ * CdcRx_Borrow() hands out the received bytes where they are, so a parser
+ * can work on them in place and CdcRx_Release() them after; CdcRx_Read()
+ * is the same with a copy into the caller's buffer. A borrow stops at the
+ * end of the ring, the bytes after the wrap come with the next one.
+ *
+ * Nothing splits the stream into '#'-terminated tokens on the way: the lock
+ * hands each borrow to PwParse_Push() (or Cred_Push()), which finds the
+ * terminator itself. An attempt split over packets or the ring wrap then
+ * needs no token buffer to be put back together, and no byte is copied.
+ *
+ * With the USBUART's Endpoint Buffer Management set to DMA with Automatic
+ * Buffer Management, the endpoint DMA writes every OUT packet into one
+ * landing buffer as it arrives, and there is no ring: CdcRx_Start() points
+ * the DMA there, CdcRx_Borrow() returns the packet in place and releasing
+ * the last of it re-arms the endpoint, so the CPU never copies it. The host
+ * is NAKed while a packet is held. USBUART_GetData() would set up a new DMA
+ * transfer per call instead of reading the packet that already arrived.
+ */
+
+#ifndef CDC_RX_RING_SIZE
+    #define CDC_RX_RING_SIZE    (256u)  // power of two, at least two packets
+#endif /* CDC_RX_RING_SIZE */
+
+#define CDC_RX_PACKET_SIZE      (64u)   // full-speed bulk max packet size
+
+#if ((CDC_RX_RING_SIZE & (CDC_RX_RING_SIZE - 1u)) != 0u) || (CDC_RX_RING_SIZE < (2u * CDC_RX_PACKET_SIZE))
+    #error "CDC_RX_RING_SIZE must be a power of two of at least two packets"
+#endif
+
+typedef struct
+{
+    uint32 packets;
+    uint32 bytes;
+    uint32 stalls;          // services that left a packet waiting for room (manual)
+    uint16 highWater;       // most bytes ever waiting in the ring
+} cdc_rx_stats_t;
+
+void CdcRx_Init(void);
+
+// Call after USBUART_CDC_Init() each time the host configures the device.
+// Only DMA with Automatic Buffer Management needs it, it arms the OUT DMA.
+void CdcRx_Start(void);
+
+// Moves the waiting OUT packet, if any, into the ring. Returns the bytes
+// taken, 0 if there was none or it does not fit yet. Call from the main
+// loop while the device is configured.
+uint16 CdcRx_Service(void);
+
+// Bytes waiting in the ring.
+uint16 CdcRx_Count(void);
+
+// The oldest received bytes in place and how many follow in one run, NULL
+// and 0 if there are none. They stay valid until released.
+const uint8 *CdcRx_Borrow(uint16 *length);
+
+// Hands back the first count bytes of the last borrow, at most its length.
+void CdcRx_Release(uint16 count);
+
+// Copies up to size bytes out of the ring, returns how many.
+uint16 CdcRx_Read(uint8 *data, uint16 size);
+
+void CdcRx_GetStats(cdc_rx_stats_t *stats);
+
+#endif /* CDC_RX_H */
+/* [] END OF FILE */
@@ -0,0 +1,212 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "project.h"
+#include "cdc_tx.h"
+#include "ep_copy.h"
+
+#define CDC_TX_MASK     (CDC_TX_RING_SIZE - 1u)
+#define CDC_TX_IN_EP    (USBUART_cdcDataInEp[USBUART_COM_PORT1])
+
+// the endpoint DMA reads the packet after USBUART_PutData() returns
+#if (USBUART_EP_MANAGEMENT_DMA)
+    #define CDC_TX_HOLD     (1u)
+#else
+    #define CDC_TX_HOLD     (0u)
+#endif /* USBUART_EP_MANAGEMENT_DMA */
+
+static uint8 ring[CDC_TX_RING_SIZE];
+static uint16 head = 0u;            // free running, CdcTx_Write
+static uint16 tail = 0u;            // free running, CdcTx_Service
+static uint16 inFlight = 0u;        // bytes after tail still being read by the DMA
+static uint8 bounce[CDC_TX_PACKET_SIZE];
+static uint32 nowMs = 0u;           // time of the last service
+static uint32 oldestMs = 0u;        // when the ring last went from empty to data
+static uint32 lastFullMs = 0u;      // when the last full packet went out
+static uint8 zlpOwed = 0u;          // the last packet was full and ended the data
+static uint8 flush = 0u;
+static cdc_tx_stats_t stats;
+
+static void CdcTx_Load(const uint8 *data, uint16 count)
+{
+    #if (USBUART_EP_MANAGEMENT_MANUAL)
+        EpCopy_LoadInEP(CDC_TX_IN_EP, data, count);
+    #else
+        USBUART_PutData(data, count);
+        #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+            // with a buffer the call only sets up the DMA, without one it sends
+            USBUART_PutData(NULL, count);
+        #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+    #endif /* USBUART_EP_MANAGEMENT_MANUAL */
+}
+
+void CdcTx_Init(void)
+{
+    head = 0u;
+    tail = 0u;
+    inFlight = 0u;
+    zlpOwed = 0u;
+    flush = 0u;
+    (void)memset(&stats, 0, sizeof(stats));
+}
+
+uint16 CdcTx_Write(const uint8 *data, uint16 length)
+{
+    uint16 used = (uint16)(head - tail);
+    uint16 at = head & CDC_TX_MASK;
+    uint16 first;
+
+    if (length > (CDC_TX_RING_SIZE - used))
+    {
+        stats.refused += (uint32)length - (CDC_TX_RING_SIZE - used);
+        length = CDC_TX_RING_SIZE - used;
+    }
+    if (0u == length)
+    {
+        return 0u;
+    }
+
+    first = CDC_TX_RING_SIZE - at;
+    if (length <= first)
+    {
+        (void)memcpy(&ring[at], data, length);
+    }
+    else
+    {
+        (void)memcpy(&ring[at], data, first);
+        (void)memcpy(ring, &data[first], (size_t)length - first);
+    }
+
+    if (inFlight == used)
+    {
+        oldestMs = nowMs;
+    }
+    head = (uint16)(head + length);
+
+    used += length;
+    if (used > stats.highWater)
+    {
+        stats.highWater = used;
+    }
+    return length;
+}
+
+uint16 CdcTx_Free(void)
+{
+    return (uint16)(CDC_TX_RING_SIZE - (uint16)(head - tail));
+}
+
+void CdcTx_Flush(void)
+{
+    flush = 1u;
+}
+
+uint8 CdcTx_Service(uint32 now)
+{
+    uint16 count;
+    uint16 at;
+    uint16 first;
+
+    nowMs = now;
+
+    // the last packet has left once the endpoint is free
+    if (0u != inFlight)
+    {
+        if (0u == USBUART_CDCIsReady())
+        {
+            return 0u;
+        }
+        tail = (uint16)(tail + inFlight);
+        inFlight = 0u;
+    }
+
+    count = (uint16)(head - tail);
+    at = tail & CDC_TX_MASK;
+
+    if (count >= CDC_TX_PACKET_SIZE)
+    {
+        count = CDC_TX_PACKET_SIZE;
+    }
+    else if (0u != count)
+    {
+        // a short packet ends the host's transfer, wait for more to join it
+        if ((0u == flush) && ((uint32)(now - oldestMs) < CDC_TX_FLUSH_MS))
+        {
+            return 0u;
+        }
+    }
+    else if ((0u == zlpOwed) || ((0u == flush) && ((uint32)(now - lastFullMs) < CDC_TX_FLUSH_MS)))
+    {
+        flush = 0u;
+        return 0u;
+    }
+
+    // the previous packet has not been taken by the host yet
+    if (0u == USBUART_CDCIsReady())
+    {
+        return 0u;
+    }
+
+    if (0u == count)
+    {
+        USBUART_PutData(NULL, 0u);
+        stats.zlps++;
+        zlpOwed = 0u;
+        flush = 0u;
+        return 1u;
+    }
+
+    first = CDC_TX_RING_SIZE - at;
+    if (count <= first)
+    {
+        CdcTx_Load(&ring[at], count);
+    }
+    else
+    {
+        (void)memcpy(bounce, &ring[at], first);
+        (void)memcpy(&bounce[first], ring, (size_t)count - first);
+        CdcTx_Load(bounce, count);
+    }
+    #if (CDC_TX_HOLD)
+        inFlight = count;
+    #else
+        tail = (uint16)(tail + count);
+    #endif /* CDC_TX_HOLD */
+
+    // a full packet leaves the transfer open until data or a ZLP follows
+    zlpOwed = (CDC_TX_PACKET_SIZE == count) ? 1u : 0u;
+    if (0u != zlpOwed)
+    {
+        lastFullMs = now;
+    }
+    if (head == (uint16)(tail + inFlight))
+    {
+        // a flush covers the ZLP after it too
+        flush &= zlpOwed;
+    }
+
+    stats.packets++;
+    stats.bytes += count;
+    return 1u;
+}
+
+uint8 CdcTx_IsIdle(void)
+{
+    return ((head == (uint16)(tail + inFlight)) && (0u == zlpOwed)) ? 1u : 0u;
+}
+
+void CdcTx_GetStats(cdc_tx_stats_t *copy)
+{
+    *copy = stats;
+}
+
+/* [] END OF FILE */
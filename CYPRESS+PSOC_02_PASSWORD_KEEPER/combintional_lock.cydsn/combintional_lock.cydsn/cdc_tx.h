@@ -0,0 +1,91 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef CDC_TX_H
+#define CDC_TX_H
+
+#include "cytypes.h"
+
+/*
+ * Bulk transmit path of the USBUART CDC port. CdcTx_Write() only copies
+ * into a power-of-two ring and never waits; CdcTx_Service() loads the IN
+ * endpoint when it is free:
+ *
+ *  - a full 64-byte packet as soon as the ring holds one
+ *  - whatever is buffered once its oldest byte has waited CDC_TX_FLUSH_MS,
+ *    or after CdcTx_Flush()
+ *  - a zero-length packet when a full packet ended the data and nothing
+ *    followed within CDC_TX_FLUSH_MS, so the host's read of an exact
+ *    multiple of 64 bytes completes
+ *
+ * A write that does not fit returns a short count; the caller keeps the
+ * rest (or stops reading its input) until CdcTx_Free() grows again.
+ * The deadline runs on the millisecond tick passed to CdcTx_Service(),
+ * which has the same 1 ms period as the bus SOF. Both calls belong to the
+ * main loop, nothing here is interrupt safe.
+ *
+ * In manual endpoint mode a packet is loaded with EpCopy_LoadInEP(), which
+ * picks a faster copy into the endpoint than USBUART_PutData()'s byte loop.
+ *
+ * In the DMA endpoint modes USBUART_PutData() only starts the transfer and
+ * the DMA reads the source later, so the bytes of a packet stay in the
+ * ring until the endpoint is free again. With Automatic Buffer Management
+ * a call with a buffer only sets up the DMA; a second call without one
+ * sends the packet.
+ */
+
+#ifndef CDC_TX_RING_SIZE
+    #define CDC_TX_RING_SIZE    (256u)  // power of two, at least two packets
+#endif /* CDC_TX_RING_SIZE */
+
+#ifndef CDC_TX_FLUSH_MS
+    #define CDC_TX_FLUSH_MS     (1u)
+#endif /* CDC_TX_FLUSH_MS */
+
+#define CDC_TX_PACKET_SIZE      (64u)   // full-speed bulk max packet size
+
+#if ((CDC_TX_RING_SIZE & (CDC_TX_RING_SIZE - 1u)) != 0u) || (CDC_TX_RING_SIZE < (2u * CDC_TX_PACKET_SIZE))
+    #error "CDC_TX_RING_SIZE must be a power of two of at least two packets"
+#endif
+
+typedef struct
+{
+    uint32 packets;         // data packets, ZLPs not included
+    uint32 bytes;
+    uint32 zlps;
+    uint32 refused;         // bytes CdcTx_Write() could not take
+    uint16 highWater;       // most bytes ever waiting in the ring
+} cdc_tx_stats_t;
+
+void CdcTx_Init(void);
+
+// Copies as much of data as fits, returns how many bytes were taken.
+uint16 CdcTx_Write(const uint8 *data, uint16 length);
+
+// Room left in the ring.
+uint16 CdcTx_Free(void);
+
+// Sends what is buffered, and the ZLP if one is owed, without waiting for
+// the deadline. It still goes out from CdcTx_Service().
+void CdcTx_Flush(void);
+
+// Loads the next packet if one is due and the IN endpoint is free.
+// Returns 1 if it loaded one (ZLPs included). Call from the main loop
+// while the device is configured.
+uint8 CdcTx_Service(uint32 nowMs);
+
+// 1 once everything written, ZLP included, is in the endpoint.
+uint8 CdcTx_IsIdle(void);
+
+void CdcTx_GetStats(cdc_tx_stats_t *stats);
+
+#endif /* CDC_TX_H */
+/* [] END OF FILE */
@@ -0,0 +1,154 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "cred.h"
+
+#define CRED_ROTL(x, b)     ((uint64)(((x) << (b)) | ((x) >> (64u - (b)))))
+
+static void Cred_SipRound(uint64 v[4])
+{
+    v[0] += v[1];
+    v[1] = CRED_ROTL(v[1], 13u);
+    v[1] ^= v[0];
+    v[0] = CRED_ROTL(v[0], 32u);
+    v[2] += v[3];
+    v[3] = CRED_ROTL(v[3], 16u);
+    v[3] ^= v[2];
+    v[0] += v[3];
+    v[3] = CRED_ROTL(v[3], 21u);
+    v[3] ^= v[0];
+    v[2] += v[1];
+    v[1] = CRED_ROTL(v[1], 17u);
+    v[1] ^= v[2];
+    v[2] = CRED_ROTL(v[2], 32u);
+}
+
+static void Cred_Compress(uint64 v[4], uint64 m)
+{
+    v[3] ^= m;
+    Cred_SipRound(v);
+    Cred_SipRound(v);
+    v[0] ^= m;
+}
+
+static void Cred_Start(cred_attempt_t *attempt)
+{
+    const uint32 *key = attempt->table->key;
+    uint64 k0 = ((uint64)key[1] << 32u) | key[0];
+    uint64 k1 = ((uint64)key[3] << 32u) | key[2];
+
+    attempt->v[0] = k0 ^ 0x736f6d6570736575ull;
+    attempt->v[1] = k1 ^ 0x646f72616e646f6dull;
+    attempt->v[2] = k0 ^ 0x6c7967656e657261ull;
+    attempt->v[3] = k1 ^ 0x7465646279746573ull;
+    attempt->block = 0u;
+    attempt->length = 0u;
+}
+
+static void Cred_Feed(cred_attempt_t *attempt, const uint8 *data, uint16 length)
+{
+    uint16 i;
+
+    for (i = 0u; (i < length) && (attempt->length <= CRED_MAX_LEN); i++)
+    {
+        attempt->block |= (uint64)data[i] << (8u * (attempt->length & 7u));
+        attempt->length++;
+        if (0u == (attempt->length & 7u))
+        {
+            Cred_Compress(attempt->v, attempt->block);
+            attempt->block = 0u;
+        }
+    }
+}
+
+static uint64 Cred_Final(cred_attempt_t *attempt)
+{
+    uint64 last = ((uint64)attempt->length << 56u) | attempt->block;
+    uint64 *v = attempt->v;
+
+    Cred_Compress(v, last);
+    v[2] ^= 0xFFu;
+    Cred_SipRound(v);
+    Cred_SipRound(v);
+    Cred_SipRound(v);
+    Cred_SipRound(v);
+    return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+void Cred_Begin(cred_attempt_t *attempt, const cred_table_t *table)
+{
+    attempt->table = table;
+    attempt->user = CRED_NO_USER;
+    Cred_Start(attempt);
+}
+
+uint8 Cred_Push(cred_attempt_t *attempt, const uint8 *data, uint16 length, uint16 *used)
+{
+    const uint8 *end = (const uint8 *)memchr(data, CRED_TERMINATOR, length);
+    uint16 part = (NULL != end) ? (uint16)(end - data) : length;
+    uint8 tooLong;
+
+    // past CRED_MAX_LEN the attempt is only searched for its end
+    Cred_Feed(attempt, data, part);
+    if (NULL == end)
+    {
+        *used = length;
+        return CRED_NONE;
+    }
+
+    *used = part + 1u;
+    tooLong = (attempt->length > CRED_MAX_LEN) ? 1u : 0u;
+    attempt->user = Cred_Lookup(attempt->table, Cred_Final(attempt));
+    if (0u != tooLong)
+    {
+        attempt->user = CRED_NO_USER;
+    }
+    Cred_Start(attempt);
+
+    return (CRED_NO_USER != attempt->user) ? CRED_ACCEPT : CRED_REJECT;
+}
+
+uint64 Cred_Digest(const cred_table_t *table, const uint8 *code, uint8 length)
+{
+    cred_attempt_t attempt;
+
+    attempt.table = table;
+    Cred_Start(&attempt);
+    Cred_Feed(&attempt, code, length);
+    return Cred_Final(&attempt);
+}
+
+uint16 Cred_Lookup(const cred_table_t *table, uint64 digest)
+{
+    uint32 mask = table->slots - 1u;
+    uint32 home = (uint32)digest & mask;
+    uint32 lo = (uint32)digest;
+    uint32 hi = (uint32)(digest >> 32u);
+    uint32 user = CRED_NO_USER;
+    const cred_entry_t *slot;
+    uint32 diff;
+    uint32 match;
+    uint8 i;
+
+    // every slot of the window is compared and merged, whatever matches
+    for (i = 0u; i < CRED_PROBE_WINDOW; i++)
+    {
+        slot = &table->entries[(home + i) & mask];
+        diff = (slot->digestLo ^ lo) | (slot->digestHi ^ hi);
+        match = ((diff | (0u - diff)) >> 31u) - 1u;     // all ones when diff is 0
+        user = (user & ~match) | ((uint32)slot->user & match);
+    }
+
+    return (uint16)user;
+}
+
+/* [] END OF FILE */
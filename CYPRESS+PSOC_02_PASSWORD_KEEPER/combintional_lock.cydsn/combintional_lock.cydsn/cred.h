@@ -0,0 +1,93 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef CRED_H
+#define CRED_H
+
+#include "cytypes.h"
+
+/*
+ * User codes of the lock. The flash table holds no codes, only a 64-bit
+ * SipHash-2-4 digest of each, keyed with a per-site salt, in an
+ * open-addressing index. The low bits of the digest give a code's home
+ * slot, and the table is built so that every code sits within
+ * CRED_PROBE_WINDOW slots of its home. An attempt is hashed as it streams
+ * in, then that one window is read and all of its slots are compared,
+ * merged with masks instead of branches. The cost does not depend on the
+ * number of users or on which slot, if any, matched.
+ *
+ * The table is generated on a PC from a CSV file by sim/cred_tool.c into
+ * cred_table.c. The tool uses Robin Hood insertion at a load of at most
+ * one half, and picks a new salt or a bigger table when a code would land
+ * outside its window. Note that a salted digest of a short PIN only keeps
+ * the codes from being read straight out of flash: anyone with the image
+ * can still try all 10,000 four-digit codes offline.
+ */
+
+#ifndef CRED_TERMINATOR
+    #define CRED_TERMINATOR     ('#')
+#endif /* CRED_TERMINATOR */
+
+#define CRED_MAX_LEN            (32u)   // longer attempts are rejected
+#define CRED_PROBE_WINDOW       (8u)    // slots compared per attempt
+#define CRED_NO_USER            (0xFFFFu)
+#define CRED_EMPTY              (0xFFFFFFFFu)   // both digest words of an empty slot
+
+// Cred_Push() results
+#define CRED_NONE               (0u)    // no terminator in the data yet
+#define CRED_ACCEPT             (1u)
+#define CRED_REJECT             (2u)
+
+typedef struct
+{
+    uint32 digestLo;
+    uint32 digestHi;
+    uint16 user;                // CRED_NO_USER in an empty slot
+    uint16 reserved;
+} cred_entry_t;
+
+typedef struct
+{
+    uint32 key[4];              // SipHash key, the site salt
+    uint32 slots;               // power of two, at least CRED_PROBE_WINDOW
+    uint32 users;
+    const cred_entry_t *entries;
+} cred_table_t;
+
+typedef struct
+{
+    const cred_table_t *table;
+    uint64 v[4];                // SipHash state
+    uint64 block;               // bytes not compressed yet
+    uint8 length;               // stops counting at CRED_MAX_LEN + 1
+    uint16 user;                // valid after CRED_ACCEPT
+} cred_attempt_t;
+
+// The site's table, from cred_table.c
+extern const cred_table_t Cred_table;
+
+void Cred_Begin(cred_attempt_t *attempt, const cred_table_t *table);
+
+// Hashes data up to and including the next terminator and sets *used to
+// the bytes taken. On the terminator it looks the attempt up and returns
+// the verdict, attempt->user is the user on CRED_ACCEPT; the next call
+// starts a new attempt.
+uint8 Cred_Push(cred_attempt_t *attempt, const uint8 *data, uint16 length, uint16 *used);
+
+// Digest of a whole code, as stored in the table. The all-ones digest
+// marks empty slots and is never given to a user.
+uint64 Cred_Digest(const cred_table_t *table, const uint8 *code, uint8 length);
+
+// User whose digest this is, CRED_NO_USER if none. Constant time.
+uint16 Cred_Lookup(const cred_table_t *table, uint64 digest);
+
+#endif /* CRED_H */
+/* [] END OF FILE */
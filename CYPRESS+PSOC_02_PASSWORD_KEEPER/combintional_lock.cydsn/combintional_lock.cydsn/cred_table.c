@@ -0,0 +1,40 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Generated by sim/cred_tool.c from credentials.csv, do not edit.
+ * 3 users in 8 slots, 96 bytes of flash.
+ */
+
+#include "cred.h"
+
+static const cred_entry_t credEntries[8u] =
+{
+    { 0xEFFA5D20u, 0x24093AC5u, 0x0002u, 0u },
+    { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFu, 0u },
+    { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFu, 0u },
+    { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFu, 0u },
+    { 0x39E7531Cu, 0x8C5B746Fu, 0x0001u, 0u },
+    { 0xD7CF092Du, 0xD62C7F5Eu, 0x0003u, 0u },
+    { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFu, 0u },
+    { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFu, 0u },
+};
+
+const cred_table_t Cred_table =
+{
+    { 0xA565305Eu, 0x207FB8A5u, 0x1A46BB24u, 0x1E3A3561u },
+    8u,
+    3u,
+    credEntries
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,412 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "USBUART_pvt.h"
+#include "ep_copy.h"
+
+#define EP_COPY_USE_DMA     (CY_PSOC5LP && (0u != EP_COPY_DMA_MIN))
+#define EP_COPY_ALIGNED(p)  (0u == ((uint32)(p) & 3u))
+
+#if (USBUART_EP_MANAGEMENT_MANUAL)
+
+#if (EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE)
+    static uint8 dmaChannel = CY_DMA_INVALID_CHANNEL;
+    static uint8 dmaTd = CY_DMA_INVALID_TD;
+#endif /* EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE */
+
+static void EpCopy_WriteBytes(reg8 *reg, const uint8 *data, uint16 length)
+{
+    while (length >= 4u)
+    {
+        *reg = data[0];
+        *reg = data[1];
+        *reg = data[2];
+        *reg = data[3];
+        data = &data[4];
+        length -= 4u;
+    }
+    while (0u != length)
+    {
+        *reg = *data;
+        data++;
+        length--;
+    }
+}
+
+// data must be 4-byte aligned; one load per four register writes
+static void EpCopy_WriteWords(reg8 *reg, const uint8 *data, uint16 length)
+{
+    const uint32 *word = (const uint32 *)(const void *)data;
+    uint32 value;
+
+    while (length >= 4u)
+    {
+        value = *word;
+        word++;
+        *reg = (uint8)value;
+        *reg = (uint8)(value >> 8u);
+        *reg = (uint8)(value >> 16u);
+        *reg = (uint8)(value >> 24u);
+        length -= 4u;
+    }
+    EpCopy_WriteBytes(reg, (const uint8 *)(const void *)word, length);
+}
+
+static void EpCopy_ReadBytes(reg8 *reg, uint8 *data, uint16 length)
+{
+    while (length >= 4u)
+    {
+        data[0] = *reg;
+        data[1] = *reg;
+        data[2] = *reg;
+        data[3] = *reg;
+        data = &data[4];
+        length -= 4u;
+    }
+    while (0u != length)
+    {
+        *data = *reg;
+        data++;
+        length--;
+    }
+}
+
+static void EpCopy_ReadWords(reg8 *reg, uint8 *data, uint16 length)
+{
+    uint32 *word = (uint32 *)(void *)data;
+    uint32 value;
+
+    while (length >= 4u)
+    {
+        // one statement per read keeps the register order
+        value = *reg;
+        value |= (uint32)*reg << 8u;
+        value |= (uint32)*reg << 16u;
+        value |= (uint32)*reg << 24u;
+        *word = value;
+        word++;
+        length -= 4u;
+    }
+    EpCopy_ReadBytes(reg, (uint8 *)(void *)word, length);
+}
+
+#if (EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE)
+    // Returns 0 once the transfer is done, 1 if the DMA cannot do it.
+    static uint8 EpCopy_Dma(reg8 *reg, uint32 first, uint16 length, uint8 toEndpoint)
+    {
+        uint32 last = first + length - 1u;
+        uint8 state;
+
+        // a TD only carries the low 16 bits of the RAM address
+        if ((CY_DMA_INVALID_CHANNEL == dmaChannel) || (HI16(first) != HI16(last)))
+        {
+            return 1u;
+        }
+
+        if (0u != toEndpoint)
+        {
+            (void)CyDmaChSetExtendedAddress(dmaChannel, HI16(first), HI16((uint32)reg));
+            (void)CyDmaTdSetConfiguration(dmaTd, length, CY_DMA_DISABLE_TD, CY_DMA_TD_INC_SRC_ADR);
+            (void)CyDmaTdSetAddress(dmaTd, LO16(first), LO16((uint32)reg));
+        }
+        else
+        {
+            (void)CyDmaChSetExtendedAddress(dmaChannel, HI16((uint32)reg), HI16(first));
+            (void)CyDmaTdSetConfiguration(dmaTd, length, CY_DMA_DISABLE_TD, CY_DMA_TD_INC_DST_ADR);
+            (void)CyDmaTdSetAddress(dmaTd, LO16((uint32)reg), LO16(first));
+        }
+        (void)CyDmaChSetInitialTd(dmaChannel, dmaTd);
+        (void)CyDmaChEnable(dmaChannel, 1u);
+        (void)CyDmaChSetRequest(dmaChannel, CY_DMA_CPU_REQ);
+
+        // the request clears when the channel starts, the chain once the TD is done
+        while (0u != CyDmaChGetRequest(dmaChannel))
+        {
+        }
+        do
+        {
+            (void)CyDmaChStatus(dmaChannel, NULL, &state);
+        } while (0u != (state & CY_DMA_STATUS_CHAIN_ACTIVE));
+
+        return 0u;
+    }
+#endif /* EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE */
+
+static void EpCopy_ToEp(uint8 epNumber, const uint8 *data, uint16 length, ep_copy_method_t method)
+{
+    reg8 *reg = &USBUART_ARB_EP_BASE.arbEp[epNumber].rwDr;
+    uint16 i;
+
+    switch (method)
+    {
+        case EP_COPY_BYTE:
+            for (i = 0u; i < length; i++)
+            {
+                *reg = data[i];
+            }
+            break;
+
+    #if (EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE)
+        case EP_COPY_DMA:
+            if (0u == EpCopy_Dma(reg, (uint32)data, length, 1u))
+            {
+                break;
+            }
+            EpCopy_WriteBytes(reg, data, length);
+            break;
+    #endif /* EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE */
+
+        case EP_COPY_WORD:
+            EpCopy_WriteWords(reg, data, length);
+            break;
+
+        default:
+            EpCopy_WriteBytes(reg, data, length);
+            break;
+    }
+}
+
+static void EpCopy_FromEp(uint8 epNumber, uint8 *data, uint16 length, ep_copy_method_t method)
+{
+    reg8 *reg = &USBUART_ARB_EP_BASE.arbEp[epNumber].rwDr;
+    uint16 i;
+
+    switch (method)
+    {
+        case EP_COPY_BYTE:
+            for (i = 0u; i < length; i++)
+            {
+                data[i] = *reg;
+            }
+            break;
+
+    #if (EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE)
+        case EP_COPY_DMA:
+            if (0u == EpCopy_Dma(reg, (uint32)data, length, 0u))
+            {
+                break;
+            }
+            EpCopy_ReadBytes(reg, data, length);
+            break;
+    #endif /* EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE */
+
+        case EP_COPY_WORD:
+            EpCopy_ReadWords(reg, data, length);
+            break;
+
+        default:
+            EpCopy_ReadBytes(reg, data, length);
+            break;
+    }
+}
+
+static ep_copy_method_t EpCopy_Choose(const uint8 *data, uint16 length)
+{
+    #if (EP_COPY_USE_DMA)
+        if ((length >= EP_COPY_DMA_MIN) && (CY_DMA_INVALID_CHANNEL != dmaChannel))
+        {
+            return EP_COPY_DMA;
+        }
+    #else
+        (void)length;
+    #endif /* EP_COPY_USE_DMA */
+
+    return EP_COPY_ALIGNED(data) ? EP_COPY_WORD : EP_COPY_UNROLLED;
+}
+
+#if (EP_COPY_BENCH_ENABLE)
+    static void EpCopy_Rewind(uint8 epNumber)
+    {
+        uint16 offset = USBUART_EP[epNumber].buffOffset;
+
+        USBUART_ARB_EP_BASE.arbEp[epNumber].rwWa    = LO8(offset);
+        USBUART_ARB_EP_BASE.arbEp[epNumber].rwWaMsb = HI8(offset);
+        USBUART_ARB_EP_BASE.arbEp[epNumber].rwRa    = LO8(offset);
+        USBUART_ARB_EP_BASE.arbEp[epNumber].rwRaMsb = HI8(offset);
+    }
+
+    static void EpCopy_BenchRun(uint8 epNumber, ep_copy_bench_t *result)
+    {
+        static uint32 buffer[64u / 4u];     // word aligned for EP_COPY_WORD
+        uint8 *bytes = (uint8 *)(void *)buffer;
+        uint8 interruptState;
+        uint32 start;
+        uint8 size;
+        uint8 method;
+        uint8 i;
+
+        for (i = 0u; i < sizeof(buffer); i++)
+        {
+            bytes[i] = i;
+        }
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        for (size = 0u; size < EP_COPY_BENCH_SIZES; size++)
+        {
+            for (method = 0u; method < (uint8)EP_COPY_METHODS; method++)
+            {
+                if ((EP_COPY_DMA == method) && (CY_DMA_INVALID_CHANNEL == dmaChannel))
+                {
+                    continue;
+                }
+
+                // nothing else may take the bus or the CPU meanwhile
+                interruptState = CyEnterCriticalSection();
+
+                EpCopy_Rewind(epNumber);
+                start = DWT->CYCCNT;
+                EpCopy_ToEp(epNumber, bytes, result->length[size], (ep_copy_method_t)method);
+                result->inCycles[size][method] = DWT->CYCCNT - start;
+
+                EpCopy_Rewind(epNumber);
+                start = DWT->CYCCNT;
+                EpCopy_FromEp(epNumber, bytes, result->length[size], (ep_copy_method_t)method);
+                result->outCycles[size][method] = DWT->CYCCNT - start;
+
+                EpCopy_Rewind(epNumber);
+                CyExitCriticalSection(interruptState);
+            }
+        }
+    }
+#endif /* EP_COPY_BENCH_ENABLE */
+
+#endif /* USBUART_EP_MANAGEMENT_MANUAL */
+
+void EpCopy_Init(void)
+{
+    #if (USBUART_EP_MANAGEMENT_MANUAL && (EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE))
+        uint8 channel;
+        uint8 td;
+
+        if (CY_DMA_INVALID_CHANNEL != dmaChannel)
+        {
+            return;
+        }
+
+        channel = CyDmaChAlloc();
+        if (CY_DMA_INVALID_CHANNEL == channel)
+        {
+            return;
+        }
+        td = CyDmaTdAllocate();
+        if (CY_DMA_INVALID_TD == td)
+        {
+            (void)CyDmaChFree(channel);
+            return;
+        }
+
+        // one-byte bursts, the whole TD runs on a single request
+        (void)CyDmaChSetConfiguration(channel, 1u, 0u, 0u, 0u, 0u);
+        dmaChannel = channel;
+        dmaTd = td;
+    #endif /* USBUART_EP_MANAGEMENT_MANUAL && (EP_COPY_USE_DMA || EP_COPY_BENCH_ENABLE) */
+}
+
+void EpCopy_LoadInEP(uint8 epNumber, const uint8 data[], uint16 length)
+{
+    #if (USBUART_EP_MANAGEMENT_MANUAL)
+        if ((epNumber > USBUART_EP0) && (epNumber < USBUART_MAX_EP))
+        {
+            #if (USBUART_16BITS_EP_ACCESS_ENABLE)
+                if ((NULL != data) && EP_COPY_ALIGNED(data) && (0u == (length & 1u)))
+                {
+                    USBUART_LoadInEP16(epNumber, data, length);
+                    return;
+                }
+            #endif /* USBUART_16BITS_EP_ACCESS_ENABLE */
+
+            if (length > (USBUART_EPX_DATA_BUF_MAX - USBUART_EP[epNumber].buffOffset))
+            {
+                length = USBUART_EPX_DATA_BUF_MAX - USBUART_EP[epNumber].buffOffset;
+            }
+
+            USBUART_SIE_EP_BASE.sieEp[epNumber].epCnt0 = (uint8)HI8(length) | USBUART_EP[epNumber].epToggle;
+            USBUART_SIE_EP_BASE.sieEp[epNumber].epCnt1 = (uint8)LO8(length);
+
+            if ((NULL != data) && (0u != length))
+            {
+                EpCopy_ToEp(epNumber, data, length, EpCopy_Choose(data, length));
+            }
+
+            USBUART_EP[epNumber].apiEpState = USBUART_NO_EVENT_PENDING;
+            USBUART_SIE_EP_BASE.sieEp[epNumber].epCr0 = USBUART_EP[epNumber].epMode;
+        }
+    #else
+        USBUART_LoadInEP(epNumber, data, length);
+    #endif /* USBUART_EP_MANAGEMENT_MANUAL */
+}
+
+uint16 EpCopy_ReadOutEP(uint8 epNumber, uint8 data[], uint16 length)
+{
+    #if (USBUART_EP_MANAGEMENT_MANUAL)
+        uint16 count;
+
+        if ((NULL == data) || (epNumber <= USBUART_EP0) || (epNumber >= USBUART_MAX_EP))
+        {
+            return 0u;
+        }
+
+        #if (USBUART_16BITS_EP_ACCESS_ENABLE)
+            if (EP_COPY_ALIGNED(data) && (0u == (length & 1u)))
+            {
+                return USBUART_ReadOutEP16(epNumber, data, length);
+            }
+        #endif /* USBUART_16BITS_EP_ACCESS_ENABLE */
+
+        count = USBUART_GetEPCount(epNumber);
+        if (length > count)
+        {
+            length = count;
+        }
+        if (0u != length)
+        {
+            EpCopy_FromEp(epNumber, data, length, EpCopy_Choose(data, length));
+        }
+
+        // re-armed only after the packet has been copied out
+        USBUART_EnableOutEP(epNumber);
+        return length;
+    #else
+        return USBUART_ReadOutEP(epNumber, data, length);
+    #endif /* USBUART_EP_MANAGEMENT_MANUAL */
+}
+
+#if (EP_COPY_BENCH_ENABLE)
+    static const uint16 benchLength[EP_COPY_BENCH_SIZES] = { 8u, 32u, 64u };
+
+    void EpCopy_Bench(uint8 epNumber, ep_copy_bench_t *result)
+    {
+        uint8 size;
+        uint8 method;
+
+        for (size = 0u; size < EP_COPY_BENCH_SIZES; size++)
+        {
+            result->length[size] = benchLength[size];
+            for (method = 0u; method < (uint8)EP_COPY_METHODS; method++)
+            {
+                result->inCycles[size][method] = 0u;
+                result->outCycles[size][method] = 0u;
+            }
+        }
+
+        // the endpoint DMA does the copy in the other modes, nothing to time
+        #if (USBUART_EP_MANAGEMENT_MANUAL)
+            EpCopy_BenchRun(epNumber, result);
+        #else
+            (void)epNumber;
+        #endif /* USBUART_EP_MANAGEMENT_MANUAL */
+    }
+#endif /* EP_COPY_BENCH_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef EP_COPY_H
+#define EP_COPY_H
+
+#include "cytypes.h"
+
+/*
+ * Faster stand-ins for USBUART_LoadInEP() and USBUART_ReadOutEP() in
+ * manual endpoint mode. They arm the endpoint exactly as the generated
+ * calls do, only the copy through the arbiter data register differs; each
+ * call picks the cheapest one for its buffer:
+ *
+ *  - EP_COPY_DMA_MIN bytes or more: a one-shot DMA transfer between the
+ *    buffer and arbEp[].rwDr, started by a CPU request and waited for
+ *  - a 4-byte aligned buffer: whole words from RAM, one register access
+ *    per byte, unrolled four times
+ *  - anything else: bytes, unrolled four times
+ *
+ * The PSoC 5LP arbiter only has the 8-bit rwDr; the 16-bit rwDr16 that
+ * USBUART_LoadInEP16()/USBUART_ReadOutEP16() use exists on PSoC 4 only,
+ * where an even-length aligned buffer goes through them instead.
+ *
+ * The DMA channel and TD come from the free pool (CyDmaChAlloc), so
+ * nothing is needed in TopDesign. If none is left the CPU copies.
+ * In the DMA endpoint modes both calls fall through to the generated ones,
+ * the endpoint DMA already does the copy.
+ *
+ * EP_COPY_BENCH_ENABLE adds EpCopy_Bench(), which times every method with
+ * the DWT cycle counter for 8, 32 and 64 bytes, to choose EP_COPY_DMA_MIN
+ * on the board.
+ */
+
+#ifndef EP_COPY_DMA_MIN
+    #define EP_COPY_DMA_MIN         (32u)   // 0 never uses the DMA
+#endif /* EP_COPY_DMA_MIN */
+
+#ifndef EP_COPY_BENCH_ENABLE
+    #define EP_COPY_BENCH_ENABLE    (0u)
+#endif /* EP_COPY_BENCH_ENABLE */
+
+typedef enum
+{
+    EP_COPY_BYTE = 0,       // the generated byte loop, for reference
+    EP_COPY_UNROLLED,
+    EP_COPY_WORD,
+    EP_COPY_DMA,
+    EP_COPY_METHODS
+} ep_copy_method_t;
+
+#define EP_COPY_BENCH_SIZES         (3u)    // 8, 32 and 64 bytes
+
+typedef struct
+{
+    uint16 length[EP_COPY_BENCH_SIZES];
+    uint32 inCycles[EP_COPY_BENCH_SIZES][EP_COPY_METHODS];     // 0 if unavailable
+    uint32 outCycles[EP_COPY_BENCH_SIZES][EP_COPY_METHODS];
+} ep_copy_bench_t;
+
+// Takes the DMA channel, call once after USBUART_Start().
+void EpCopy_Init(void);
+
+// Same contracts as USBUART_LoadInEP() and USBUART_ReadOutEP().
+void EpCopy_LoadInEP(uint8 epNumber, const uint8 data[], uint16 length);
+uint16 EpCopy_ReadOutEP(uint8 epNumber, uint8 data[], uint16 length);
+
+#if (EP_COPY_BENCH_ENABLE)
+    // Copies through the buffer of an idle endpoint and rewinds it after
+    // each run; the endpoint is never armed. The device must be configured
+    // so the endpoint has its buffer.
+    void EpCopy_Bench(uint8 epNumber, ep_copy_bench_t *result);
+#endif /* EP_COPY_BENCH_ENABLE */
+
+#endif /* EP_COPY_H */
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <stddef.h>
+#include "evq.h"
+
+typedef struct
+{
+    uint32 atMs;
+    evq_handler_t handler;      // NULL for a free entry
+    uint16 arg;
+} evq_entry_t;
+
+static evq_entry_t evq[EVQ_SIZE];
+static uint8 evqCount = 0u;
+
+void Evq_Init(void)
+{
+    uint8 i;
+
+    for (i = 0u; i < EVQ_SIZE; i++)
+    {
+        evq[i].handler = NULL;
+    }
+    evqCount = 0u;
+}
+
+uint8 Evq_Post(uint32 atMs, evq_handler_t handler, uint16 arg)
+{
+    uint8 i;
+
+    for (i = 0u; i < EVQ_SIZE; i++)
+    {
+        if (NULL == evq[i].handler)
+        {
+            evq[i].atMs = atMs;
+            evq[i].handler = handler;
+            evq[i].arg = arg;
+            evqCount++;
+            return 0u;
+        }
+    }
+
+    return 1u;
+}
+
+uint8 Evq_Cancel(evq_handler_t handler)
+{
+    uint8 dropped = 0u;
+    uint8 i;
+
+    for (i = 0u; i < EVQ_SIZE; i++)
+    {
+        if (handler == evq[i].handler)
+        {
+            evq[i].handler = NULL;
+            dropped++;
+        }
+    }
+    evqCount -= dropped;
+
+    return dropped;
+}
+
+uint8 Evq_Service(uint32 nowMs)
+{
+    evq_entry_t event;
+    uint32 late;
+    uint32 latest;
+    uint8 ran = 0u;
+    uint8 next;
+    uint8 i;
+
+    while (0u != evqCount)
+    {
+        // the most overdue entry first; one in the future shows up as a
+        // huge unsigned lateness and is skipped
+        next = EVQ_SIZE;
+        latest = 0u;
+        for (i = 0u; i < EVQ_SIZE; i++)
+        {
+            if (NULL != evq[i].handler)
+            {
+                late = nowMs - evq[i].atMs;
+                if ((late <= 0x7FFFFFFFu) && ((EVQ_SIZE == next) || (late > latest)))
+                {
+                    next = i;
+                    latest = late;
+                }
+            }
+        }
+        if (EVQ_SIZE == next)
+        {
+            break;
+        }
+
+        // free the entry first so the handler can post into it
+        event = evq[next];
+        evq[next].handler = NULL;
+        evqCount--;
+        event.handler(event.atMs, event.arg);
+        ran++;
+    }
+
+    return ran;
+}
+
+uint8 Evq_Pending(void)
+{
+    return evqCount;
+}
+
+/* [] END OF FILE */
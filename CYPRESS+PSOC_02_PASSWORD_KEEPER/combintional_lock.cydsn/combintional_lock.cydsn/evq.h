@@ -0,0 +1,49 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef EVQ_H
+#define EVQ_H
+
+#include "cytypes.h"
+
+/*
+ * Timed events for the main loop. Evq_Post() schedules a handler for a
+ * time in milliseconds and Evq_Service() runs the ones that are due, in
+ * time order, from the main loop: handlers may draw on the LCD or post
+ * further events, but must not block. The queue is a fixed pool of
+ * EVQ_SIZE entries, there is no allocation and nothing runs from an
+ * interrupt.
+ */
+
+#ifndef EVQ_SIZE
+    #define EVQ_SIZE    (8u)
+#endif /* EVQ_SIZE */
+
+// Gets the time the event was due, which later steps can be posted from
+// without drifting, and the argument it was posted with.
+typedef void (*evq_handler_t)(uint32 dueMs, uint16 arg);
+
+void Evq_Init(void);
+
+// Returns 0 on success, 1 if the queue is full.
+uint8 Evq_Post(uint32 atMs, evq_handler_t handler, uint16 arg);
+
+// Drops every pending event of handler, returns how many there were.
+uint8 Evq_Cancel(evq_handler_t handler);
+
+// Runs every event due at nowMs, returns how many ran.
+uint8 Evq_Service(uint32 nowMs);
+
+// Events waiting to run
+uint8 Evq_Pending(void);
+
+#endif /* EVQ_H */
+/* [] END OF FILE */
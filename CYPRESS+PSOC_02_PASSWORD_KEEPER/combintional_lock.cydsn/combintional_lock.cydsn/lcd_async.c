@@ -0,0 +1,197 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "lcd_async.h"
+
+#define LCD_ASYNC_MASK          (LCD_ASYNC_QUEUE_SIZE - 1u)
+#define LCD_ASYNC_RS            (0x100u)    // queue entry is a data byte
+#define LCD_ASYNC_SLOW_TICKS    ((LCD_ASYNC_SLOW_CMD_US + LCD_ASYNC_TICK_US - 1u) / LCD_ASYNC_TICK_US)
+
+#if (LCD_ASYNC_ENABLE)
+
+static uint16 queue[LCD_ASYNC_QUEUE_SIZE];
+static volatile uint8 head = 0u;        // written by the caller
+static volatile uint8 tail = 0u;        // written by the interrupt
+static volatile uint8 busy = 0u;        // timer running
+
+static uint16 current;                  // byte whose low nibble is still owed
+static uint8 lowPending = 0u;
+static uint8 holdTicks = 0u;
+
+static lcd_async_callback_t callback = NULL;
+
+// Same pin sequence as LCD_WrDatNib()/LCD_WrCntrlNib(), without the wait.
+static void LcdAsync_WriteNibble(uint8 nibble, uint16 entry)
+{
+    if (0u != (entry & LCD_ASYNC_RS))
+    {
+        LCD_PORT_DR_REG |= LCD_RS;
+    }
+    else
+    {
+        LCD_PORT_DR_REG &= ((uint8)(~LCD_RS));
+    }
+    LCD_PORT_DR_REG &= ((uint8)(~(LCD_RW | LCD_DATA_MASK)));
+
+    #if(0u != LCD_PORT_SHIFT)
+        LCD_PORT_DR_REG |= (LCD_E | ((uint8)(((uint8) nibble) << LCD_PORT_SHIFT)));
+    #else
+        LCD_PORT_DR_REG |= (LCD_E | nibble);
+    #endif /* (0u != LCD_PORT_SHIFT) */
+
+    // minimum of 230 ns
+    CyDelayUs(1u);
+
+    LCD_PORT_DR_REG &= ((uint8)(~LCD_E));
+}
+
+/*
+ * One nibble per tick. The tick after a low nibble is the HD44780's
+ * execution time, so the bus is never read back.
+ */
+static CY_ISR(LcdAsync_Isr)
+{
+    (void)LCD_Timer_ReadStatusRegister();
+
+    if (0u != holdTicks)
+    {
+        holdTicks--;
+    }
+    else if (0u != lowPending)
+    {
+        LcdAsync_WriteNibble((uint8)(current & 0x0Fu), current);
+        lowPending = 0u;
+
+        // clear display and return home are the only slow commands
+        if ((0u == (current & LCD_ASYNC_RS)) && (0u != current) && (current <= LCD_RESET_CURSOR_POSITION))
+        {
+            holdTicks = LCD_ASYNC_SLOW_TICKS;
+        }
+    }
+    else if (head != tail)
+    {
+        current = queue[tail];
+        tail = (uint8)((tail + 1u) & LCD_ASYNC_MASK);
+
+        LcdAsync_WriteNibble((uint8)((current >> LCD_NIBBLE_SHIFT) & 0x0Fu), current);
+        lowPending = 1u;
+    }
+    else
+    {
+        LCD_Timer_Stop();
+        busy = 0u;
+
+        if (NULL != callback)
+        {
+            callback();
+        }
+    }
+}
+
+static void LcdAsync_Put(uint16 entry)
+{
+    uint8 next = (uint8)((head + 1u) & LCD_ASYNC_MASK);
+    uint8 interruptState;
+
+    // full: the interrupt frees a slot every two ticks
+    while (next == tail)
+    {
+    }
+
+    queue[head] = entry;
+    head = next;
+
+    interruptState = CyEnterCriticalSection();
+    if (0u == busy)
+    {
+        busy = 1u;
+        LCD_Timer_Enable();
+    }
+    CyExitCriticalSection(interruptState);
+}
+
+void LcdAsync_Start(void)
+{
+    LCD_Timer_Init();
+    isr_LCD_StartEx(&LcdAsync_Isr);
+}
+
+void LcdAsync_WriteControl(uint8 cByte)
+{
+    LcdAsync_Put(cByte);
+}
+
+void LcdAsync_WriteData(uint8 dByte)
+{
+    LcdAsync_Put(LCD_ASYNC_RS | dByte);
+}
+
+uint8 LcdAsync_IsIdle(void)
+{
+    return (0u == busy) ? 1u : 0u;
+}
+
+void LcdAsync_SetCallback(lcd_async_callback_t newCallback)
+{
+    callback = newCallback;
+}
+
+#else
+
+void LcdAsync_Start(void)
+{
+}
+
+void LcdAsync_WriteControl(uint8 cByte)
+{
+    LCD_WriteControl(cByte);
+}
+
+void LcdAsync_WriteData(uint8 dByte)
+{
+    LCD_WriteData(dByte);
+}
+
+uint8 LcdAsync_IsIdle(void)
+{
+    return 1u;
+}
+
+void LcdAsync_SetCallback(lcd_async_callback_t newCallback)
+{
+    (void)newCallback;
+}
+
+#endif /* LCD_ASYNC_ENABLE */
+
+void LcdAsync_Position(uint8 row, uint8 column)
+{
+    LcdAsync_WriteControl((uint8)(((0u == row) ? LCD_ROW_0_START : LCD_ROW_1_START) + column));
+}
+
+void LcdAsync_PrintString(char8 const string[])
+{
+    while ((char8)'\0' != *string)
+    {
+        LcdAsync_WriteData((uint8)*string);
+        string++;
+    }
+}
+
+void LcdAsync_WaitIdle(void)
+{
+    while (0u == LcdAsync_IsIdle())
+    {
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,65 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef LCD_FB_H
+#define LCD_FB_H
+
+#include "cytypes.h"
+
+/*
+ * RAM shadow of the 2x16 character LCD. Drawing only touches RAM;
+ * LcdFb_Flush() sends the cells that differ from what the display already
+ * shows, so no unchanged character goes over the bus twice. It only clears
+ * the display when that plus redrawing the new text sends fewer bytes than
+ * blanking the old text cell by cell. Text past the end of a row is
+ * clipped.
+ *
+ * The bytes go through lcd_async, so with LCD_ASYNC_ENABLE a flush only
+ * queues them and returns. LCD_FB_MEASURE_CYCLES times each flush with the
+ * DWT cycle counter to compare the queued and blocking builds.
+ */
+#ifndef LCD_FB_MEASURE_CYCLES
+    #define LCD_FB_MEASURE_CYCLES   (0u)
+#endif /* LCD_FB_MEASURE_CYCLES */
+
+// Clear display counted in bus bytes. It is one byte, so the flush sends
+// the fewest bytes, but it holds the controller ~1.5 ms, about as long as
+// 15 bytes take at two nibble ticks each: 15 weighs that time instead,
+// 0xFFFF never clears.
+#ifndef LCD_FB_CLEAR_COST
+    #define LCD_FB_CLEAR_COST       (1u)
+#endif /* LCD_FB_CLEAR_COST */
+
+#define LCD_FB_ROWS     (2u)
+#define LCD_FB_COLS     (16u)
+
+// Call once right after LCD_Start(), which leaves the display blank.
+// Also starts lcd_async.
+void LcdFb_Init(void);
+
+// Blanks the shadow and homes the draw cursor, nothing is sent.
+void LcdFb_Clear(void);
+
+void LcdFb_Position(uint8 row, uint8 column);
+void LcdFb_PutChar(char8 character);
+void LcdFb_PrintString(char8 const string[]);
+void LcdFb_PrintNumber(uint16 value);
+
+// Sends the changed cells, returns the number of bytes written to the LCD.
+uint16 LcdFb_Flush(void);
+
+#if (LCD_FB_MEASURE_CYCLES)
+    // CPU cycles spent inside the last LcdFb_Flush().
+    uint32 LcdFb_LastFlushCycles(void);
+#endif /* LCD_FB_MEASURE_CYCLES */
+
+#endif /* LCD_FB_H */
+/* [] END OF FILE */
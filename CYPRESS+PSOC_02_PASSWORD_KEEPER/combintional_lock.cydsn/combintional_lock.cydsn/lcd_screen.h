@@ -0,0 +1,46 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef LCD_SCREEN_H
+#define LCD_SCREEN_H
+
+#include "cytypes.h"
+#include "lcd_fb.h"
+
+/*
+ * Declarative screens. A screen is a const table of row templates, so the
+ * text stays in flash, and the values are filled in when it is drawn:
+ *
+ *   %u  next argument as an unsigned number (promoted uint8/uint16)
+ *   %s  next argument as a string
+ *   %c  next argument as a character
+ *   %%  a literal '%'
+ *
+ * A row starts at column 0, leading spaces position the text and the rest
+ * of the row is blank, so templates need no trailing padding. A NULL row is
+ * blank. Drawing goes through lcd_fb, so a screen that shares text with the
+ * one before only sends the cells that differ.
+ */
+
+typedef struct
+{
+    char8 const *rows[LCD_FB_ROWS];
+} lcd_screen_t;
+
+// Draws the screen into the lcd_fb shadow and leaves the draw cursor after
+// the last character; nothing is sent, so more can be drawn on top.
+void LcdScreen_Draw(const lcd_screen_t *screen, ...);
+
+// Draws the screen and flushes, returns the bytes written to the LCD.
+uint16 LcdScreen_Show(const lcd_screen_t *screen, ...);
+
+#endif /* LCD_SCREEN_H */
+/* [] END OF FILE */
@@ -0,0 +1,236 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "cred.h"
+#include "evq.h"
+#include "lcd_fb.h"
+#include "lcd_screen.h"
+#include "lock.h"
+#include "pw_parse.h"
+#include "stream.h"
+
+// Define LED states
+#define LED_ON  (1u)
+#define LED_OFF (0u)
+
+// lock_step_t LEDs
+#define LOCK_LED_1  (0x01u)
+#define LOCK_LED_2  (0x02u)
+
+#define USBUART_BUFFER_SIZE (64u)
+
+typedef struct
+{
+    uint16 afterMs;                 // time since the previous step
+    const lcd_screen_t *screen;     // NULL ends the sequence
+    uint8 leds;
+} lock_step_t;
+
+// Checks the received password as it arrives, separately on each link
+#if (LOCK_CRED_TABLE)
+    static cred_attempt_t attempt[STREAM_LINKS];
+#else
+    #define PASSWORD_LENGTH 4
+    static const char8 setPassword[PASSWORD_LENGTH + 1] = "1234"; // Set password, typed as "1234#"
+    static pw_parse_t attempt[STREAM_LINKS];
+#endif /* LOCK_CRED_TABLE */
+
+// Screens of the lock, the text stays in flash
+static const lcd_screen_t screenMatch   = {{ "Password Match:", "User %u" }};
+static const lcd_screen_t screenOpen    = {{ "Lock is open", "Access granted" }};
+static const lcd_screen_t screenInvalid = {{ "Invalid Password", NULL }};
+static const lcd_screen_t screenDenied  = {{ "Access denied", NULL }};
+static const lcd_screen_t screenRetry   = {{ "Enter Correct", "Password" }};
+
+static const lock_step_t stepsAccept[] =
+{
+    { 0u,               &screenMatch,   LOCK_LED_1 | LOCK_LED_2 },
+    { LOCK_FEEDBACK_MS, &screenOpen,    LOCK_LED_1 | LOCK_LED_2 },
+    { 0u,               NULL,           0u }
+};
+
+static const lock_step_t stepsReject[] =
+{
+    { 0u,               &screenInvalid, LOCK_LED_1 },
+    { LOCK_FEEDBACK_MS, &screenDenied,  LOCK_LED_1 },
+    { LOCK_FEEDBACK_MS, &screenRetry,   LOCK_LED_1 },
+    { 0u,               NULL,           0u }
+};
+
+static const lock_step_t *lockSteps = stepsReject;
+static uint16 lockUser = 0u;
+static uint8 lockBusy = 0u;
+static lock_stats_t lockStats;
+
+static void Lock_Step(uint32 dueMs, uint16 index)
+{
+    const lock_step_t *step = &lockSteps[index];
+
+    Pin_1_Write((0u != (step->leds & LOCK_LED_1)) ? LED_ON : LED_OFF);
+    Pin_2_Write((0u != (step->leds & LOCK_LED_2)) ? LED_ON : LED_OFF);
+    (void)LcdScreen_Show(step->screen, lockUser);
+
+    // timed from when this step was due, so late service does not add up
+    if (NULL != step[1].screen)
+    {
+        (void)Evq_Post(dueMs + step[1].afterMs, &Lock_Step, index + 1u);
+    }
+    else
+    {
+        lockBusy = 0u;
+    }
+}
+
+static void Lock_Feedback(uint32 nowMs, uint8 accepted, uint16 user)
+{
+    if (0u != accepted)
+    {
+        lockSteps = stepsAccept;
+        lockStats.accepted++;
+    }
+    else
+    {
+        lockSteps = stepsReject;
+        lockStats.rejected++;
+    }
+    lockUser = user;
+
+    (void)Evq_Cancel(&Lock_Step);
+    lockBusy = 1u;
+    Lock_Step(nowMs, 0u);
+}
+
+void Lock_Init(void)
+{
+    uint8 link;
+
+    Evq_Init();
+    #if (STREAM_CDC_ENABLE)
+        Stream_Start(STREAM_CDC);
+    #endif /* STREAM_CDC_ENABLE */
+    #if (STREAM_UART_ENABLE)
+        Stream_Start(STREAM_UART);
+    #endif /* STREAM_UART_ENABLE */
+    for (link = 0u; link < STREAM_LINKS; link++)
+    {
+        #if (LOCK_CRED_TABLE)
+            Cred_Begin(&attempt[link], &Cred_table);
+        #else
+            PwParse_Init(&attempt[link], setPassword, PASSWORD_LENGTH);
+        #endif /* LOCK_CRED_TABLE */
+    }
+
+    lockBusy = 0u;
+    lockStats.accepted = 0u;
+    lockStats.rejected = 0u;
+}
+
+// Echoes and checks received bytes where they lie in the receive path.
+static void Lock_Handle(uint8 link, uint32 nowMs, const uint8 *data, uint16 count)
+{
+    uint16 pos;
+    uint16 used;
+    uint16 i;
+    uint8 verdict;
+
+    for (i = 0u; i < count; i++)
+    {
+        LcdFb_PutChar((char8)data[i]);
+    }
+
+    // on CDC the echo goes out in full packets, or after CDC_TX_FLUSH_MS
+    (void)Stream_Write(link, data, count);
+
+    for (pos = 0u; pos < count; pos += used)
+    {
+        #if (LOCK_CRED_TABLE)
+            verdict = Cred_Push(&attempt[link], &data[pos], count - pos, &used);
+            if (CRED_NONE != verdict)
+            {
+                Lock_Feedback(nowMs, (CRED_ACCEPT == verdict) ? 1u : 0u, attempt[link].user);
+            }
+        #else
+            verdict = PwParse_Push(&attempt[link], &data[pos], count - pos, &used);
+            if (PW_PARSE_NONE != verdict)
+            {
+                Lock_Feedback(nowMs, (PW_PARSE_ACCEPT == verdict) ? 1u : 0u, 1u);
+            }
+        #endif /* LOCK_CRED_TABLE */
+    }
+}
+
+// One pass over one link; called with a constant link, so the stream calls
+// reduce to that backend's.
+static CY_INLINE void Lock_PollLink(uint8 link, uint32 nowMs)
+{
+    const uint8 *data;
+    uint16 count;
+    uint16 room;
+    uint16 budget = USBUART_BUFFER_SIZE;
+
+    if (0u == Stream_IsUp(link))
+    {
+        return;
+    }
+
+    // what has arrived goes into the receive path, then up to a packet is
+    // handled in place; no more is taken than the echo can take, the rest
+    // waits there (and on CDC then in the endpoint)
+    Stream_Receive(link);
+    room = Stream_Writable(link);
+    if (room < budget)
+    {
+        budget = room;
+    }
+    while (0u != budget)
+    {
+        data = Stream_Borrow(link, &count);
+        if (NULL == data)
+        {
+            break;
+        }
+        if (count > budget)
+        {
+            count = budget;
+        }
+        Lock_Handle(link, nowMs, data, count);
+        Stream_Release(link, count);
+        budget -= count;
+    }
+    (void)Stream_Service(link, nowMs);
+}
+
+void Lock_Poll(uint32 nowMs)
+{
+    (void)Evq_Service(nowMs);
+
+    // both links every pass, so neither waits on the other
+    #if (STREAM_CDC_ENABLE)
+        Lock_PollLink(STREAM_CDC, nowMs);
+    #endif /* STREAM_CDC_ENABLE */
+    #if (STREAM_UART_ENABLE)
+        Lock_PollLink(STREAM_UART, nowMs);
+    #endif /* STREAM_UART_ENABLE */
+    (void)LcdFb_Flush();
+}
+
+uint8 Lock_IsFeedbackBusy(void)
+{
+    return lockBusy;
+}
+
+void Lock_GetStats(lock_stats_t *stats)
+{
+    *stats = lockStats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,58 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef LOCK_H
+#define LOCK_H
+
+#include "cytypes.h"
+
+/*
+ * The lock application: takes the typed characters from the USB CDC port,
+ * the UART or both (STREAM_CDC_ENABLE and STREAM_UART_ENABLE in stream.h),
+ * echoes them back on the same link and to the LCD, checks each
+ * '#'-terminated code (each link separately) and plays the feedback.
+ * Feedback is a table of steps (screen, LEDs, time since the previous
+ * step) run by the timed event queue, so the loop keeps receiving and
+ * echoing while a message is on screen. A new verdict, from either link,
+ * replaces a sequence that is still playing.
+ *
+ * Lock_Poll() is one pass of the main loop and never waits for the
+ * feedback; main.c starts the hardware and calls it with the tick time.
+ */
+
+// 1: user codes from the hashed table in cred_table.c, 0: the single setPassword
+#ifndef LOCK_CRED_TABLE
+    #define LOCK_CRED_TABLE     (1u)
+#endif /* LOCK_CRED_TABLE */
+
+// How long each feedback message stays before the next one
+#ifndef LOCK_FEEDBACK_MS
+    #define LOCK_FEEDBACK_MS    (2000u)
+#endif /* LOCK_FEEDBACK_MS */
+
+typedef struct
+{
+    uint32 accepted;
+    uint32 rejected;
+} lock_stats_t;
+
+// After LcdFb_Init(), USBUART_Start() and, with the UART, UART_1_Start().
+void Lock_Init(void);
+
+void Lock_Poll(uint32 nowMs);
+
+// 1 while a feedback sequence still has steps to play
+uint8 Lock_IsFeedbackBusy(void);
+
+void Lock_GetStats(lock_stats_t *stats);
+
+#endif /* LOCK_H */
+/* [] END OF FILE */
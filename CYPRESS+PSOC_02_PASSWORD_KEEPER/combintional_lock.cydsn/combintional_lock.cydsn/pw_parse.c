@@ -0,0 +1,60 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "pw_parse.h"
+
+void PwParse_Init(pw_parse_t *parser, const char8 *secret, uint8 length)
+{
+    parser->secret = secret;
+    parser->length = (length > PW_PARSE_MAX_LEN) ? PW_PARSE_MAX_LEN : length;
+    parser->pos = 0u;
+    parser->rejected = 0u;
+}
+
+uint8 PwParse_Push(pw_parse_t *parser, const uint8 *data, uint16 length, uint16 *used)
+{
+    const uint8 *end;
+    uint16 i = 0u;
+    uint8 verdict;
+
+    // compare until the first wrong or surplus byte
+    while ((0u == parser->rejected) && (i < length))
+    {
+        if (PW_PARSE_TERMINATOR == data[i])
+        {
+            break;
+        }
+        if ((parser->pos >= parser->length) || ((uint8)parser->secret[parser->pos] != data[i]))
+        {
+            parser->rejected = 1u;
+        }
+        parser->pos++;
+        i++;
+    }
+
+    // a rejected attempt only needs its end found
+    end = (const uint8 *)memchr(&data[i], PW_PARSE_TERMINATOR, (size_t)length - i);
+    if (NULL == end)
+    {
+        *used = length;
+        return PW_PARSE_NONE;
+    }
+
+    *used = (uint16)((end - data) + 1);
+    verdict = ((0u == parser->rejected) && (parser->pos == parser->length)) ?
+              PW_PARSE_ACCEPT : PW_PARSE_REJECT;
+    parser->pos = 0u;
+    parser->rejected = 0u;
+    return verdict;
+}
+
+/* [] END OF FILE */
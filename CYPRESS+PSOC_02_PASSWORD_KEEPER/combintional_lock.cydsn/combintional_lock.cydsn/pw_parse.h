@@ -0,0 +1,55 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef PW_PARSE_H
+#define PW_PARSE_H
+
+#include "cytypes.h"
+
+/*
+ * Streaming password check. Each byte of an attempt is compared with the
+ * stored password as it arrives, so nothing is buffered and no input can
+ * run past the end of anything. The first wrong or surplus byte rejects
+ * the attempt; the rest of it is skipped with a search for the terminator
+ * and costs no compares. The verdict is only given when the terminator
+ * arrives, in O(1), so the reply does not tell how far a guess got.
+ */
+
+#ifndef PW_PARSE_TERMINATOR
+    #define PW_PARSE_TERMINATOR     ('#')
+#endif /* PW_PARSE_TERMINATOR */
+
+#define PW_PARSE_MAX_LEN            (254u)
+
+// PwParse_Push() results
+#define PW_PARSE_NONE               (0u)    // no terminator in the data yet
+#define PW_PARSE_ACCEPT             (1u)
+#define PW_PARSE_REJECT             (2u)
+
+typedef struct
+{
+    const char8 *secret;
+    uint8 length;               // of the secret, without terminator
+    uint8 pos;                  // bytes of the attempt so far, stops at length + 1
+    uint8 rejected;
+} pw_parse_t;
+
+// The secret is not copied and must outlive the parser. length is at most
+// PW_PARSE_MAX_LEN.
+void PwParse_Init(pw_parse_t *parser, const char8 *secret, uint8 length);
+
+// Consumes data up to and including the next terminator and sets *used to
+// the bytes taken. Returns the verdict on the attempt the terminator ends;
+// the next call starts a new attempt.
+uint8 PwParse_Push(pw_parse_t *parser, const uint8 *data, uint16 length, uint16 *used);
+
+#endif /* PW_PARSE_H */
+/* [] END OF FILE */
@@ -0,0 +1,295 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "project.h"
+#include "cdc_rx.h"
+#include "cdc_tx.h"
+#include "ep_copy.h"
+#include "tick.h"
+#include "uart_ring.h"
+
+/*
+ * One byte-stream interface over the two links the lock can talk on: the
+ * USBUART CDC port (cdc_rx.c and cdc_tx.c) and the hardware UART_1
+ * (uart_ring.c). Both are buffered in rings, so every call only copies and
+ * never waits.
+ *
+ * The link is the first argument of every call. The calls are inline and
+ * pick the backend with a plain comparison, so with a constant link the
+ * compiler keeps only that backend's direct call; there is no table of
+ * function pointers and no indirect call on the receive and echo path.
+ * A link that is not built in does nothing: it is never up, reads and
+ * writes return 0 and Stream_Borrow() returns NULL.
+ *
+ * One pass of a main loop per link:
+ *
+ *   if (0u != Stream_IsUp(link))
+ *   {
+ *       Stream_Receive(link);
+ *       ... Stream_Borrow()/Stream_Release() or Stream_Read(),
+ *           Stream_Write() while Stream_Writable() ...
+ *       (void)Stream_Service(link, nowMs);
+ *   }
+ *
+ * How soon written bytes leave differs: CDC holds a short packet for up to
+ * CDC_TX_FLUSH_MS to join more bytes to it, unless Stream_Flush() is
+ * called; the UART starts sending at once.
+ */
+
+#define STREAM_CDC      (0u)
+#define STREAM_UART     (1u)
+#define STREAM_LINKS    (2u)
+
+#ifndef STREAM_CDC_ENABLE
+    #define STREAM_CDC_ENABLE   (1u)
+#endif /* STREAM_CDC_ENABLE */
+
+// UART_1 is only there with uart_ring.c built in, see uart_ring.h
+#ifndef STREAM_UART_ENABLE
+    #define STREAM_UART_ENABLE  (UART_RING_ENABLE)
+#endif /* STREAM_UART_ENABLE */
+
+// Sets up the link's buffers, call once after the component is started.
+static CY_INLINE void Stream_Start(uint8 link)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        UartRing_Start();
+        return;
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        EpCopy_Init();
+        CdcRx_Init();
+        CdcTx_Init();
+        return;
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+}
+
+// 1 while the link can carry data. For CDC this also restarts the port
+// each time the host configures the device.
+static CY_INLINE uint8 Stream_IsUp(uint8 link)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return 1u;
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        if (0u != USBUART_IsConfigurationChanged())
+        {
+            if (0u != USBUART_GetConfiguration())
+            {
+                (void)USBUART_CDC_Init();
+                CdcRx_Start();
+                CdcTx_Init();
+            }
+        }
+        return (0u != USBUART_GetConfiguration()) ? 1u : 0u;
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    return 0u;
+}
+
+// Takes what has arrived into the receive ring; the UART's interrupt
+// already has.
+static CY_INLINE void Stream_Receive(uint8 link)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return;
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        (void)CdcRx_Service();
+        return;
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+}
+
+// Received bytes waiting to be read.
+static CY_INLINE uint16 Stream_Readable(uint8 link)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return UartRing_Count();
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        return CdcRx_Count();
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    return 0u;
+}
+
+// Copies up to size received bytes, returns how many.
+static CY_INLINE uint16 Stream_Read(uint8 link, uint8 *data, uint16 size)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return UartRing_Read(data, size);
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        return CdcRx_Read(data, size);
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    (void)data;
+    (void)size;
+    return 0u;
+}
+
+// The oldest received bytes in place, see CdcRx_Borrow().
+static CY_INLINE const uint8 *Stream_Borrow(uint8 link, uint16 *length)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return UartRing_Borrow(length);
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        return CdcRx_Borrow(length);
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    *length = 0u;
+    return NULL;
+}
+
+static CY_INLINE void Stream_Release(uint8 link, uint16 count)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        UartRing_Release(count);
+        return;
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        CdcRx_Release(count);
+        return;
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    (void)count;
+}
+
+// Room for writing without a short count.
+static CY_INLINE uint16 Stream_Writable(uint8 link)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return UartRing_Free();
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        return CdcTx_Free();
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    return 0u;
+}
+
+// Queues as much of data as fits, returns how many bytes were taken.
+static CY_INLINE uint16 Stream_Write(uint8 link, const uint8 *data, uint16 length)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return UartRing_Write(data, length);
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        return CdcTx_Write(data, length);
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    (void)data;
+    (void)length;
+    return 0u;
+}
+
+// Sends what is written without waiting to join more to it.
+static CY_INLINE void Stream_Flush(uint8 link)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return;
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        CdcTx_Flush();
+        return;
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+}
+
+// Moves written bytes on towards the wire. Returns 1 when CDC loaded a
+// packet or the UART saw an idle line end received data.
+static CY_INLINE uint8 Stream_Service(uint8 link, uint32 nowMs)
+{
+#if (STREAM_UART_ENABLE)
+    if (STREAM_UART == link)
+    {
+        return UartRing_Service(Tick_GetUs());
+    }
+#endif /* STREAM_UART_ENABLE */
+#if (STREAM_CDC_ENABLE)
+    if (STREAM_CDC == link)
+    {
+        return CdcTx_Service(nowMs);
+    }
+#endif /* STREAM_CDC_ENABLE */
+    (void)link;
+    (void)nowMs;
+    return 0u;
+}
+
+#endif /* STREAM_H */
+/* [] END OF FILE */
@@ -0,0 +1,128 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "lcd_screen.h"
+#include "stream.h"
+#include "stream_bench.h"
+#include "tick.h"
+
+#if (STREAM_UART == STREAM_BENCH_LINK)
+    #define STREAM_BENCH_NAME   "UART"
+#else
+    #define STREAM_BENCH_NAME   "USB CDC"
+#endif /* STREAM_UART == STREAM_BENCH_LINK */
+
+// a prime period, so the pattern never lines up with packets or rings
+#define STREAM_BENCH_PERIOD     (251u)
+
+#define STREAM_BENCH_CHUNK      (64u)
+
+static const lcd_screen_t screenBench = {{ "%s loop", "%u KB/s %u err" }};
+
+void StreamBench_Start(stream_bench_t *bench)
+{
+    Stream_Start(STREAM_BENCH_LINK);
+    bench->sent = 0u;
+    bench->received = 0u;
+    bench->errors = 0u;
+}
+
+void StreamBench_Poll(stream_bench_t *bench, uint32 nowMs)
+{
+    uint8 chunk[STREAM_BENCH_CHUNK];
+    const uint8 *data;
+    uint16 count;
+    uint16 room;
+    uint16 i;
+
+    if (0u == Stream_IsUp(STREAM_BENCH_LINK))
+    {
+        return;
+    }
+    Stream_Receive(STREAM_BENCH_LINK);
+
+    // check what came back where it lies
+    for (;;)
+    {
+        data = Stream_Borrow(STREAM_BENCH_LINK, &count);
+        if (NULL == data)
+        {
+            break;
+        }
+        for (i = 0u; i < count; i++)
+        {
+            if (data[i] != (uint8)((bench->received + i) % STREAM_BENCH_PERIOD))
+            {
+                bench->errors++;
+            }
+        }
+        bench->received += count;
+        Stream_Release(STREAM_BENCH_LINK, count);
+    }
+
+    // keep STREAM_BENCH_IN_FLIGHT bytes out
+    for (;;)
+    {
+        room = STREAM_BENCH_IN_FLIGHT - (uint16)(bench->sent - bench->received);
+        if (room > Stream_Writable(STREAM_BENCH_LINK))
+        {
+            room = Stream_Writable(STREAM_BENCH_LINK);
+        }
+        if (room > STREAM_BENCH_CHUNK)
+        {
+            room = STREAM_BENCH_CHUNK;
+        }
+        if (0u == room)
+        {
+            break;
+        }
+        for (i = 0u; i < room; i++)
+        {
+            chunk[i] = (uint8)((bench->sent + i) % STREAM_BENCH_PERIOD);
+        }
+        bench->sent += Stream_Write(STREAM_BENCH_LINK, chunk, room);
+    }
+    if ((bench->sent - bench->received) >= STREAM_BENCH_IN_FLIGHT)
+    {
+        Stream_Flush(STREAM_BENCH_LINK);
+    }
+    (void)Stream_Service(STREAM_BENCH_LINK, nowMs);
+}
+
+void StreamBench_Run(void)
+{
+    stream_bench_t bench;
+    uint32 windowMs;
+    uint32 windowBytes = 0u;
+    uint32 nowMs;
+
+    StreamBench_Start(&bench);
+    (void)LcdScreen_Show(&screenBench, STREAM_BENCH_NAME, 0u, 0u);
+    windowMs = Tick_GetMs();
+
+    for (;;)
+    {
+        nowMs = Tick_GetMs();
+        StreamBench_Poll(&bench, nowMs);
+
+        if ((uint32)(nowMs - windowMs) >= STREAM_BENCH_WINDOW_MS)
+        {
+            (void)LcdScreen_Show(&screenBench, STREAM_BENCH_NAME,
+                (uint16)(((bench.received - windowBytes) * 1000u) / ((uint32)(nowMs - windowMs) * 1024u)),
+                (uint16)((bench.errors > 0xFFFFu) ? 0xFFFFu : bench.errors));
+            windowBytes = bench.received;
+            windowMs = nowMs;
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,73 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef STREAM_BENCH_H
+#define STREAM_BENCH_H
+
+#include "cytypes.h"
+#include "stream.h"
+
+/*
+ * Loopback throughput benchmark of one stream backend. Built with
+ * STREAM_BENCH_ENABLE set to 1, main.c runs StreamBench_Run() instead of
+ * the lock. It writes a counting pattern to STREAM_BENCH_LINK through the
+ * stream calls, reads back what the far end returns and checks it, and
+ * every STREAM_BENCH_WINDOW_MS shows the KB/s that came back in the last
+ * window and the bytes that came back wrong so far.
+ *
+ * At most STREAM_BENCH_IN_FLIGHT bytes are out at a time, so the far end
+ * never has to buffer more; when that is reached the rest is flushed
+ * rather than held back for a fuller CDC packet.
+ *
+ * The far end has to return every byte:
+ *  - STREAM_CDC: the host echoes the port, e.g. on Linux
+ *    stty -F /dev/ttyACM0 raw -echo && cat /dev/ttyACM0 > /dev/ttyACM0
+ *  - STREAM_UART: a wire from the UART_1 tx pin to its rx pin
+ */
+
+#ifndef STREAM_BENCH_ENABLE
+    #define STREAM_BENCH_ENABLE     (0u)
+#endif /* STREAM_BENCH_ENABLE */
+
+#ifndef STREAM_BENCH_LINK
+    #define STREAM_BENCH_LINK       (STREAM_CDC)
+#endif /* STREAM_BENCH_LINK */
+
+#if (STREAM_BENCH_ENABLE) && (((STREAM_CDC == STREAM_BENCH_LINK) && (0u == STREAM_CDC_ENABLE)) || \
+                              ((STREAM_UART == STREAM_BENCH_LINK) && (0u == STREAM_UART_ENABLE)))
+    #error "STREAM_BENCH_LINK is not built in, see stream.h"
+#endif /* STREAM_BENCH_ENABLE */
+
+#ifndef STREAM_BENCH_IN_FLIGHT
+    #define STREAM_BENCH_IN_FLIGHT  (256u)
+#endif /* STREAM_BENCH_IN_FLIGHT */
+
+#define STREAM_BENCH_WINDOW_MS      (1000u)
+
+typedef struct
+{
+    uint32 sent;
+    uint32 received;
+    uint32 errors;          // received bytes that were not the next of the pattern
+} stream_bench_t;
+
+// Starts the link and clears the counts.
+void StreamBench_Start(stream_bench_t *bench);
+
+// One pass: reads and checks what came back, tops up what is out.
+void StreamBench_Poll(stream_bench_t *bench, uint32 nowMs);
+
+// After USBUART_Start() (or UART_1_Start()), LcdFb_Init() and
+// Tick_Start(); never returns.
+void StreamBench_Run(void);
+
+#endif /* STREAM_BENCH_H */
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "tick.h"
+
+#define TICK_CYCLES_PER_US  (BCLK__BUS_CLK__HZ / 1000000u)
+
+static volatile uint32 tickMs = 0u;
+static volatile uint8 tickPending = 0u;
+
+static CY_ISR(Tick_Isr)
+{
+    tickMs += TICK_PERIOD_MS;
+    tickPending = 1u;
+}
+
+void Tick_Start(void)
+{
+    // SysTick runs from the CPU clock, no schematic component needed
+    (void)CyIntSetSysVector(CY_INT_SYSTICK_IRQN, &Tick_Isr);
+    (void)SysTick_Config((BCLK__BUS_CLK__HZ / 1000u) * TICK_PERIOD_MS);
+}
+
+uint32 Tick_GetMs(void)
+{
+    // 32-bit reads are atomic on the Cortex-M3
+    return tickMs;
+}
+
+uint8 Tick_Pending(void)
+{
+    uint8 pending;
+    uint8 interruptState = CyEnterCriticalSection();
+
+    pending = tickPending;
+    tickPending = 0u;
+
+    CyExitCriticalSection(interruptState);
+    return pending;
+}
+
+uint32 Tick_GetUs(void)
+{
+    uint32 ms;
+    uint32 elapsed;
+    uint8 interruptState = CyEnterCriticalSection();
+
+    ms = tickMs;
+    elapsed = SysTick->LOAD - SysTick->VAL;
+    // the counter wrapped but the interrupt has not run yet
+    if (0u != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+    {
+        ms += TICK_PERIOD_MS;
+        elapsed = SysTick->LOAD - SysTick->VAL;
+    }
+
+    CyExitCriticalSection(interruptState);
+    return (ms * 1000u) + (elapsed / TICK_CYCLES_PER_US);
+}
+
+void Tick_Advance(uint32 ms)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    tickMs += ms;
+    tickPending = 1u;
+
+    CyExitCriticalSection(interruptState);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,36 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef TICK_H
+#define TICK_H
+
+#include "cytypes.h"
+
+#define TICK_PERIOD_MS  (1u)
+
+// Starts the SysTick based 1 ms system tick.
+void Tick_Start(void);
+
+// Milliseconds since Tick_Start(), wraps after ~49 days.
+uint32 Tick_GetMs(void);
+
+// Returns 1 once for every tick interrupt that happened since the last call.
+uint8 Tick_Pending(void);
+
+// Microseconds since Tick_Start(), for measuring short intervals; wraps
+// after ~71 minutes.
+uint32 Tick_GetUs(void);
+
+// Adds time that passed while SysTick was stopped, e.g. in Sleep mode.
+void Tick_Advance(uint32 ms);
+
+#endif /* TICK_H */
+/* [] END OF FILE */
@@ -0,0 +1,370 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "project.h"
+#include "uart_ring.h"
+#include "tick.h"
+
+#if (UART_RING_ENABLE)
+
+#define UART_RING_RX_MASK   (UART_RING_RX_SIZE - 1u)
+#define UART_RING_TX_MASK   (UART_RING_TX_SIZE - 1u)
+
+#define UART_RING_RX_ERRORS (UART_1_RX_STS_OVERRUN | UART_1_RX_STS_STOP_ERROR | \
+                             UART_1_RX_STS_PAR_ERROR | UART_1_RX_STS_BREAK)
+
+static uint8 rxRing[UART_RING_RX_SIZE];
+static volatile uint16 rxHead = 0u;     // free running, RX interrupt
+static volatile uint16 rxTail = 0u;     // free running, UartRing_Read
+static volatile uint32 rxLastUs = 0u;   // when the last byte came in
+static volatile uint8 rxActive = 0u;    // bytes came in since the last idle line
+
+static uint8 txRing[UART_RING_TX_SIZE];
+static volatile uint16 txHead = 0u;     // free running, UartRing_Write
+static volatile uint16 txTail = 0u;     // free running, as bytes reach the UART
+
+static volatile uart_ring_stats_t stats;
+
+// Empties the RX FIFO, also on errors alone. Reading the status clears the
+// sticky error bits and with them the interrupt.
+static CY_ISR(UartRing_RxIsr)
+{
+    uint8 status;
+    uint16 used;
+
+    for (;;)
+    {
+        status = UART_1_ReadRxStatus();
+
+        if (0u != (status & UART_RING_RX_ERRORS))
+        {
+            if (0u != (status & UART_1_RX_STS_OVERRUN))
+            {
+                stats.overruns++;
+            }
+            if (0u != (status & UART_1_RX_STS_STOP_ERROR))
+            {
+                stats.framing++;
+            }
+            if (0u != (status & UART_1_RX_STS_PAR_ERROR))
+            {
+                stats.parity++;
+            }
+            if (0u != (status & UART_1_RX_STS_BREAK))
+            {
+                stats.breaks++;
+            }
+        }
+
+        if (0u == (status & UART_1_RX_STS_FIFO_NOTEMPTY))
+        {
+            break;
+        }
+
+        used = (uint16)(rxHead - rxTail);
+        if (used < UART_RING_RX_SIZE)
+        {
+            rxRing[rxHead & UART_RING_RX_MASK] = UART_1_ReadRxData();
+            rxHead++;
+            stats.rxBytes++;
+            used++;
+            if (used > stats.rxHighWater)
+            {
+                stats.rxHighWater = used;
+            }
+        }
+        else
+        {
+            (void)UART_1_ReadRxData();
+            stats.dropped++;
+        }
+        rxActive = 1u;
+    }
+
+    rxLastUs = Tick_GetUs();
+}
+
+#if (UART_RING_TX_DMA)
+
+#define DMA_BYTES_PER_BURST     (1u)
+#define DMA_REQUEST_PER_BURST   (1u)
+#define DMA_SRC_BASE            (CYDEV_SRAM_BASE)
+#define DMA_DST_BASE            (CYDEV_PERIPH_BASE)
+
+static uint8 dmaChannel = CY_DMA_INVALID_CHANNEL;
+static uint8 dmaTd = CY_DMA_INVALID_TD;
+static volatile uint16 txInFlight = 0u; // bytes after txTail the DMA is sending
+
+// Starts the DMA on the next contiguous run of the ring, if it is idle.
+// The FIFO_NOT_FULL request moves one byte whenever the FIFO has room.
+// Called with interrupts off or from the DMA interrupt.
+static void UartRing_Kick(void)
+{
+    uint16 count = (uint16)(txHead - txTail);
+    uint16 at = txTail & UART_RING_TX_MASK;
+
+    if ((0u != txInFlight) || (0u == count))
+    {
+        return;
+    }
+    if (count > (UART_RING_TX_SIZE - at))
+    {
+        count = UART_RING_TX_SIZE - at;
+    }
+
+    txInFlight = count;
+    (void)CyDmaTdSetConfiguration(dmaTd, count, CY_DMA_DISABLE_TD,
+                                  DMA_UART_TX__TD_TERMOUT_EN | CY_DMA_TD_INC_SRC_ADR);
+    (void)CyDmaTdSetAddress(dmaTd, LO16((uint32)&txRing[at]), LO16((uint32)UART_1_TXDATA_PTR));
+    (void)CyDmaChSetInitialTd(dmaChannel, dmaTd);
+    (void)CyDmaChEnable(dmaChannel, 1u);
+}
+
+// Runs once the DMA has put a whole run into the FIFO.
+static CY_ISR(UartRing_TxIsr)
+{
+    txTail = (uint16)(txTail + txInFlight);
+    stats.txBytes += txInFlight;
+    txInFlight = 0u;
+    UartRing_Kick();
+}
+
+#else
+
+// Tops up the TX FIFO from the ring.
+static void UartRing_Kick(void)
+{
+    while ((txHead != txTail) && (0u != (UART_1_ReadTxStatus() & UART_1_TX_STS_FIFO_NOT_FULL)))
+    {
+        UART_1_WriteTxData(txRing[txTail & UART_RING_TX_MASK]);
+        txTail++;
+        stats.txBytes++;
+    }
+}
+
+#endif /* UART_RING_TX_DMA */
+
+void UartRing_Start(void)
+{
+    rxHead = 0u;
+    rxTail = 0u;
+    rxActive = 0u;
+    txHead = 0u;
+    txTail = 0u;
+    (void)memset((void *)&stats, 0, sizeof(stats));
+
+    // the masks are what the component's Configure dialog would set
+    UART_1_SetRxInterruptMode(UART_1_RX_STS_FIFO_NOTEMPTY | UART_RING_RX_ERRORS);
+    isr_UART_RX_StartEx(&UartRing_RxIsr);
+
+#if (UART_RING_TX_DMA)
+    txInFlight = 0u;
+    UART_1_SetTxInterruptMode(UART_1_TX_STS_FIFO_NOT_FULL);
+    if (CY_DMA_INVALID_CHANNEL == dmaChannel)
+    {
+        dmaChannel = DMA_UART_TX_DmaInitialize(DMA_BYTES_PER_BURST, DMA_REQUEST_PER_BURST,
+                                               HI16(DMA_SRC_BASE), HI16(DMA_DST_BASE));
+        dmaTd = CyDmaTdAllocate();
+    }
+    isr_UART_TX_StartEx(&UartRing_TxIsr);
+#endif /* UART_RING_TX_DMA */
+}
+
+uint16 UartRing_Read(uint8 *data, uint16 size)
+{
+    uint16 count = (uint16)(rxHead - rxTail);
+    uint16 at = rxTail & UART_RING_RX_MASK;
+    uint16 first = UART_RING_RX_SIZE - at;
+
+    if (count > size)
+    {
+        count = size;
+    }
+    if (count <= first)
+    {
+        (void)memcpy(data, &rxRing[at], count);
+    }
+    else
+    {
+        (void)memcpy(data, &rxRing[at], first);
+        (void)memcpy(&data[first], rxRing, (size_t)count - first);
+    }
+
+    // only the interrupt writes rxHead, so this needs no critical section
+    rxTail = (uint16)(rxTail + count);
+    return count;
+}
+
+uint16 UartRing_Count(void)
+{
+    return (uint16)(rxHead - rxTail);
+}
+
+const uint8 *UartRing_Borrow(uint16 *length)
+{
+    uint16 count = (uint16)(rxHead - rxTail);
+    uint16 at = rxTail & UART_RING_RX_MASK;
+
+    if (count > (UART_RING_RX_SIZE - at))
+    {
+        count = UART_RING_RX_SIZE - at;
+    }
+    *length = count;
+    return (0u != count) ? &rxRing[at] : NULL;
+}
+
+void UartRing_Release(uint16 count)
+{
+    uint16 used = (uint16)(rxHead - rxTail);
+
+    rxTail = (uint16)(rxTail + ((count < used) ? count : used));
+}
+
+uint16 UartRing_Write(const uint8 *data, uint16 length)
+{
+    uint16 used = (uint16)(txHead - txTail);
+    uint16 at = txHead & UART_RING_TX_MASK;
+    uint16 first = UART_RING_TX_SIZE - at;
+    uint8 interruptState;
+
+    if (length > (UART_RING_TX_SIZE - used))
+    {
+        length = UART_RING_TX_SIZE - used;
+    }
+    if (0u == length)
+    {
+        return 0u;
+    }
+
+    if (length <= first)
+    {
+        (void)memcpy(&txRing[at], data, length);
+    }
+    else
+    {
+        (void)memcpy(&txRing[at], data, first);
+        (void)memcpy(txRing, &data[first], (size_t)length - first);
+    }
+
+    used += length;
+    if (used > stats.txHighWater)
+    {
+        stats.txHighWater = used;
+    }
+
+    interruptState = CyEnterCriticalSection();
+    txHead = (uint16)(txHead + length);
+    UartRing_Kick();
+    CyExitCriticalSection(interruptState);
+    return length;
+}
+
+uint16 UartRing_Free(void)
+{
+    return (uint16)(UART_RING_TX_SIZE - (uint16)(txHead - txTail));
+}
+
+uint8 UartRing_TxDone(void)
+{
+    return (txHead == txTail) ? 1u : 0u;
+}
+
+uint8 UartRing_Service(uint32 nowUs)
+{
+    uint8 idle = 0u;
+    uint8 interruptState;
+
+#if (!UART_RING_TX_DMA)
+    UartRing_Kick();
+#endif /* UART_RING_TX_DMA */
+
+    // a byte arriving between the two reads would be taken for the end
+    interruptState = CyEnterCriticalSection();
+    if ((0u != rxActive) && ((uint32)(nowUs - rxLastUs) >= UART_RING_IDLE_US))
+    {
+        rxActive = 0u;
+        stats.frames++;
+        idle = 1u;
+    }
+    CyExitCriticalSection(interruptState);
+
+    return idle;
+}
+
+void UartRing_GetStats(uart_ring_stats_t *copy)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    (void)memcpy(copy, (const void *)&stats, sizeof(*copy));
+    CyExitCriticalSection(interruptState);
+}
+
+#else
+
+void UartRing_Start(void)
+{
+}
+
+uint16 UartRing_Read(uint8 *data, uint16 size)
+{
+    (void)data;
+    (void)size;
+    return 0u;
+}
+
+uint16 UartRing_Count(void)
+{
+    return 0u;
+}
+
+const uint8 *UartRing_Borrow(uint16 *length)
+{
+    *length = 0u;
+    return NULL;
+}
+
+void UartRing_Release(uint16 count)
+{
+    (void)count;
+}
+
+uint16 UartRing_Write(const uint8 *data, uint16 length)
+{
+    (void)data;
+    (void)length;
+    return 0u;
+}
+
+uint16 UartRing_Free(void)
+{
+    return 0u;
+}
+
+uint8 UartRing_TxDone(void)
+{
+    return 1u;
+}
+
+uint8 UartRing_Service(uint32 nowUs)
+{
+    (void)nowUs;
+    return 0u;
+}
+
+void UartRing_GetStats(uart_ring_stats_t *copy)
+{
+    (void)memset(copy, 0, sizeof(*copy));
+}
+
+#endif /* UART_RING_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,125 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef UART_RING_H
+#define UART_RING_H
+
+#include "cytypes.h"
+
+/*
+ * Buffered driver for the hardware UART_1. The component keeps its own
+ * interrupts off and its 4-byte software buffers unused; an RX interrupt
+ * empties the hardware FIFO into a power-of-two ring as bytes arrive, and
+ * a DMA channel feeds the TX FIFO from a second ring, one contiguous run
+ * of the ring per transfer. The main loop only copies in and out.
+ *
+ * The RX interrupt counts hardware overruns, framing (stop bit) and parity
+ * errors and breaks; bytes that arrive while the ring is full are dropped
+ * and counted. UartRing_Service() reports an idle line, no byte for
+ * UART_RING_IDLE_CHARS character times after the last one, which marks the
+ * end of a frame. It is measured from the main loop, so it is seen up to
+ * one loop pass late.
+ *
+ * Needs in TopDesign:
+ *  - a UART named UART_1, RX and TX, at UART_RING_BAUD 8N1, with RX and TX
+ *    interrupts off in its Configure dialog (the masks are set at run time)
+ *  - an Interrupt named isr_UART_RX on the UART_1 rx_interrupt terminal
+ *  - a DMA named DMA_UART_TX with its drq on the UART_1 tx_interrupt
+ *    terminal and Hardware Request set to Level
+ *  - an Interrupt named isr_UART_TX on the DMA_UART_TX nrq terminal
+ * UART_1's generated files are in the project but it is not placed in the
+ * current TopDesign, so UART_RING_ENABLE is 0: every call then does
+ * nothing and nothing is ever received or sent. With UART_RING_TX_DMA set
+ * to 0 the DMA and isr_UART_TX are not needed and UartRing_Service() tops
+ * up the TX FIFO instead.
+ */
+
+#ifndef UART_RING_ENABLE
+    #define UART_RING_ENABLE        (0u)
+#endif /* UART_RING_ENABLE */
+
+#ifndef UART_RING_TX_DMA
+    #define UART_RING_TX_DMA        (1u)
+#endif /* UART_RING_TX_DMA */
+
+#ifndef UART_RING_RX_SIZE
+    #define UART_RING_RX_SIZE       (512u)  // power of two
+#endif /* UART_RING_RX_SIZE */
+
+#ifndef UART_RING_TX_SIZE
+    #define UART_RING_TX_SIZE       (512u)  // power of two
+#endif /* UART_RING_TX_SIZE */
+
+#ifndef UART_RING_BAUD
+    #define UART_RING_BAUD          (115200u)
+#endif /* UART_RING_BAUD */
+
+#ifndef UART_RING_IDLE_CHARS
+    #define UART_RING_IDLE_CHARS    (2u)
+#endif /* UART_RING_IDLE_CHARS */
+
+// 10 bits per 8N1 character
+#define UART_RING_IDLE_US   (((UART_RING_IDLE_CHARS * 10u * 1000000u) + UART_RING_BAUD - 1u) / UART_RING_BAUD)
+
+#if ((UART_RING_RX_SIZE & (UART_RING_RX_SIZE - 1u)) != 0u) || ((UART_RING_TX_SIZE & (UART_RING_TX_SIZE - 1u)) != 0u)
+    #error "UART_RING_RX_SIZE and UART_RING_TX_SIZE must be powers of two"
+#endif
+
+typedef struct
+{
+    uint32 rxBytes;
+    uint32 txBytes;
+    uint32 overruns;        // hardware FIFO overruns, bytes lost before the ISR ran
+    uint32 dropped;         // bytes lost because the RX ring was full
+    uint32 framing;         // stop bit errors
+    uint32 parity;
+    uint32 breaks;
+    uint32 frames;          // idle lines after received data
+    uint16 rxHighWater;     // most bytes ever waiting in each ring
+    uint16 txHighWater;
+} uart_ring_stats_t;
+
+// Sets up the interrupts and the DMA, call after UART_1_Start() and
+// Tick_Start().
+void UartRing_Start(void);
+
+// Copies up to size received bytes, returns how many.
+uint16 UartRing_Read(uint8 *data, uint16 size);
+
+// Received bytes waiting in the ring.
+uint16 UartRing_Count(void);
+
+// The oldest received bytes in place and how many follow in one run, NULL
+// and 0 if there are none; a run stops at the end of the ring. They stay
+// valid until released.
+const uint8 *UartRing_Borrow(uint16 *length);
+
+// Hands back the first count bytes of the last borrow, at most its length.
+void UartRing_Release(uint16 count);
+
+// Queues as much of data as fits for sending, returns how many bytes were
+// taken; never waits.
+uint16 UartRing_Write(const uint8 *data, uint16 length);
+
+// Room left in the TX ring.
+uint16 UartRing_Free(void);
+
+// 1 once every queued byte has gone into the UART.
+uint8 UartRing_TxDone(void);
+
+// Returns 1 once for each idle line that ends received data. Call from the
+// main loop with Tick_GetUs().
+uint8 UartRing_Service(uint32 nowUs);
+
+void UartRing_GetStats(uart_ring_stats_t *copy);
+
+#endif /* UART_RING_H */
+/* [] END OF FILE */
@@ -0,0 +1,283 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host benchmark of the lock's receive path: cdc_rx.c exactly as the
+ * firmware builds it, behind a model of the CDC OUT endpoint that holds one
+ * packet at a time like the SIE does. The attempts are split by token.c,
+ * which lives here: the firmware checks them as they stream in with
+ * pw_parse.c.
+ *
+ * A random stream of '#'-terminated attempts (some too long for a token)
+ * is cut into packets of random length 1..64. Each loop iteration loads the
+ * next packet when the endpoint is free, then runs the firmware loop body:
+ * CdcRx_Service(), CdcRx_Read() of up to a packet and Token_Push(). Every
+ * token is checked against the attempt that was sent, and the time from
+ * the packet carrying its '#' reaching the endpoint to the token being
+ * handed out is the latency. The worst case in nanoseconds includes host
+ * scheduling hiccups; the worst case in loop iterations does not.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn cdc_rx_bench.c ep_copy_host.c \
+ *       ../combintional_lock.cydsn/cdc_rx.c token.c \
+ *       -o cdc_rx_bench
+ *   ./cdc_rx_bench [megabytes] [bytes read per iteration] [seed]
+ *
+ * A read size below 64 models a consumer slower than the host, the ring
+ * then fills and packets wait in the endpoint.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "cdc_rx.h"
+#include "token.h"
+
+#define SIM_PACKET          (64u)
+#define SIM_MAX_ATTEMPT     (TOKEN_MAX_LEN + 8u)
+#define SIM_MAX_PENDING     (4096u)
+
+// the endpoint
+static uint8 simEp[SIM_PACKET];
+static uint16 simEpCount = 0u;
+static uint8 simEpFull = 0u;
+
+// the stream the host sends, and what should come out of it
+static uint8 *simStream;
+static uint32 simStreamLen = 0u;
+static uint32 simSent = 0u;
+static uint64 simState;
+
+// load times of packets whose '#' has not been handed out yet
+static uint64 simPending[SIM_MAX_PENDING];
+static uint32 simPendingLoop[SIM_MAX_PENDING];
+static uint32 simLoops = 0u;
+static uint32 simPendHead = 0u;
+static uint32 simPendTail = 0u;
+
+uint8 USBUART_DataIsReady(void)
+{
+    return simEpFull;
+}
+
+uint16 USBUART_GetCount(void)
+{
+    return (0u != simEpFull) ? simEpCount : 0u;
+}
+
+uint16 USBUART_GetData(uint8 *pData, uint16 length)
+{
+    if (length > simEpCount)
+    {
+        length = simEpCount;
+    }
+    (void)memcpy(pData, simEp, length);
+    // reading re-arms the endpoint, whatever was not read is gone
+    simEpFull = 0u;
+    return length;
+}
+
+uint16 USBUART_GetAll(uint8 *pData)
+{
+    return USBUART_GetData(pData, SIM_PACKET);
+}
+
+// ep_copy_host.c links it; nothing is sent back in this benchmark
+void USBUART_PutData(const uint8 *pData, uint16 length)
+{
+    (void)pData;
+    (void)length;
+}
+
+static uint32 Sim_Rand(void)
+{
+    // xorshift64*, independent of the firmware
+    simState ^= simState >> 12u;
+    simState ^= simState << 25u;
+    simState ^= simState >> 27u;
+    return (uint32)((simState * 2685821657736338717ull) >> 32u);
+}
+
+static uint64 Sim_Ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * 1000000000ull) + (uint64)now.tv_nsec;
+}
+
+static void Sim_MakeStream(uint32 size)
+{
+    uint32 length;
+    uint32 i;
+
+    simStream = (uint8 *)malloc(size + SIM_MAX_ATTEMPT + 1u);
+    while (simStreamLen < size)
+    {
+        length = Sim_Rand() % (SIM_MAX_ATTEMPT + 1u);
+        for (i = 0u; i < length; i++)
+        {
+            simStream[simStreamLen++] = (uint8)('0' + (Sim_Rand() % 10u));
+        }
+        simStream[simStreamLen++] = TOKEN_TERMINATOR;
+    }
+}
+
+// Loads the next packet of random length if the endpoint is free.
+static void Sim_HostSend(void)
+{
+    uint16 length;
+    uint16 i;
+
+    if ((0u != simEpFull) || (simSent >= simStreamLen))
+    {
+        return;
+    }
+
+    length = (uint16)(1u + (Sim_Rand() % SIM_PACKET));
+    if (length > (simStreamLen - simSent))
+    {
+        length = (uint16)(simStreamLen - simSent);
+    }
+    (void)memcpy(simEp, &simStream[simSent], length);
+    simEpCount = length;
+    simEpFull = 1u;
+    simSent += length;
+
+    for (i = 0u; i < length; i++)
+    {
+        if (TOKEN_TERMINATOR == simEp[i])
+        {
+            simPending[simPendHead % SIM_MAX_PENDING] = Sim_Ns();
+            simPendingLoop[simPendHead % SIM_MAX_PENDING] = simLoops;
+            simPendHead++;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 megabytes = 16u;
+    uint16 readSize = SIM_PACKET;
+    uint8 buffer[SIM_PACKET];
+    token_t token;
+    cdc_rx_stats_t stats;
+    uint32 expectAt = 0u;       // start of the next expected attempt in the stream
+    uint32 expectLen;
+    uint32 tokens = 0u;
+    uint32 overflows = 0u;
+    uint32 received = 0u;
+    uint8 failed = 0u;
+    uint64 latency;
+    uint64 worst = 0u;
+    uint32 loops;
+    uint32 worstLoops = 0u;
+    uint64 total = 0u;
+    uint64 start;
+    uint64 elapsed;
+    uint16 count;
+    uint16 pos;
+    uint16 used;
+    uint8 result;
+
+    simState = 0x9E3779B97F4A7C15ull;
+    if (argc > 1)
+    {
+        megabytes = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        readSize = (uint16)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3)
+    {
+        simState ^= strtoull(argv[3], NULL, 0);
+    }
+    if ((0u == readSize) || (readSize > SIM_PACKET))
+    {
+        readSize = SIM_PACKET;
+    }
+
+    Sim_MakeStream(megabytes << 20u);
+    CdcRx_Init();
+    Token_Init(&token);
+
+    start = Sim_Ns();
+    while (received < simStreamLen)
+    {
+        simLoops++;
+        Sim_HostSend();
+
+        (void)CdcRx_Service();
+        count = CdcRx_Read(buffer, readSize);
+        received += count;
+
+        for (pos = 0u; pos < count; pos += used)
+        {
+            result = Token_Push(&token, &buffer[pos], count - pos, &used);
+            if (TOKEN_NONE == result)
+            {
+                continue;
+            }
+
+            latency = Sim_Ns() - simPending[simPendTail % SIM_MAX_PENDING];
+            loops = simLoops - simPendingLoop[simPendTail % SIM_MAX_PENDING];
+            if (loops > worstLoops)
+            {
+                worstLoops = loops;
+            }
+            simPendTail++;
+            total += latency;
+            if (latency > worst)
+            {
+                worst = latency;
+            }
+
+            expectLen = (uint32)((const uint8 *)memchr(&simStream[expectAt], TOKEN_TERMINATOR,
+                simStreamLen - expectAt) - &simStream[expectAt]);
+            if (TOKEN_READY == result)
+            {
+                failed |= ((expectLen != token.length) ||
+                    (0 != memcmp(token.text, &simStream[expectAt], expectLen))) ? 1u : 0u;
+            }
+            else
+            {
+                overflows++;
+                failed |= (expectLen <= TOKEN_MAX_LEN) ? 1u : 0u;
+            }
+            expectAt += expectLen + 1u;
+            tokens++;
+        }
+    }
+    elapsed = Sim_Ns() - start;
+
+    CdcRx_GetStats(&stats);
+    printf("%u bytes in %u packets, %u-byte ring, %u bytes read per iteration\n",
+        stats.bytes, stats.packets, (uint32)CDC_RX_RING_SIZE, readSize);
+    printf("%u tokens (%u too long), ring high water %u, %u services found no room\n",
+        tokens, overflows, stats.highWater, stats.stalls);
+    printf("throughput %.1f MB/s, token latency mean %.0f ns, worst %.0f ns\n",
+        ((double)received / (1024.0 * 1024.0)) / ((double)elapsed * 1e-9),
+        (double)total / (double)tokens, (double)worst);
+    printf("worst latency in loop iterations: %u (0 = handed out in the iteration it arrived)\n",
+        worstLoops);
+    printf("every byte delivered in order: %s\n",
+        ((0u == failed) && (received == simStreamLen) && (stats.bytes == simStreamLen)) ? "ok" : "FAILED");
+
+    free(simStream);
+    return ((0u == failed) && (received == simStreamLen)) ? 0 : 1;
+}
+
+/* [] END OF FILE */
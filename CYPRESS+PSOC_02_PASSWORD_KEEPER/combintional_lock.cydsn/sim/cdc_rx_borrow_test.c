@@ -0,0 +1,344 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host test of CdcRx_Borrow() and CdcRx_Release() against a simulated SIE.
+ * The OUT endpoint holds one packet and takes the next only once it has
+ * been re-armed; the host fills it with packets of random length (ZLPs
+ * included) whenever it can. The consumer borrows, checks the bytes in
+ * place and releases a random part of them, now and then holding a borrow
+ * while more packets arrive, or reading with CdcRx_Read() instead.
+ *
+ * It checks that every byte arrives once and in order, that borrowed bytes
+ * do not change until they are released, and how the endpoint is re-armed:
+ * in manual mode as soon as the packet is in the ring, with DMA with
+ * Automatic Buffer Management only after the whole packet has been
+ * released, the borrow pointing into the buffer the endpoint DMA writes.
+ * Then it counts the bytes the CPU copies per received byte with each way
+ * of reading, for a stream of full packets.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn cdc_rx_borrow_test.c \
+ *       ep_copy_host.c ../combintional_lock.cydsn/cdc_rx.c \
+ *       -o cdc_rx_borrow_test
+ *   ./cdc_rx_borrow_test [kilobytes] [seed]
+ *
+ * Add -DUSBUART_EP_MM=2 for DMA with Automatic Buffer Management.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "cdc_rx.h"
+
+#define SIM_PACKET          (64u)
+#define SIM_DEFAULT_KB      (1024u)
+#define SIM_COPY_BYTES      (65536u)
+
+static uint64 simState = 1u;
+
+// host stream
+static uint8 *simStream;
+static uint32 simStreamLen = 0u;
+static uint32 simSent = 0u;
+static uint8 simFullOnly = 0u;      // only 64-byte packets
+
+// OUT endpoint
+static uint8 simOut[SIM_PACKET];
+static uint16 simOutCount = 0u;
+static uint8 simOutFull = 0u;
+static uint8 simArmed = 1u;         // DMA auto: the DMA has somewhere to write
+static uint8 *simLanding = NULL;    // DMA auto: where it writes
+static uint32 simCpuCopies = 0u;    // bytes the CPU read out of the endpoint
+static uint32 simEarlyArms = 0u;    // DMA auto: re-armed with bytes unreleased
+static uint32 simReleased = 0u;     // bytes the consumer has handed back
+
+static uint32 Sim_Rand(void)
+{
+    // xorshift64*, independent of the firmware
+    simState ^= simState >> 12u;
+    simState ^= simState << 25u;
+    simState ^= simState >> 27u;
+    return (uint32)((simState * 2685821657736338717ull) >> 32u);
+}
+
+// The host sends the next packet if the endpoint takes one.
+static void Sim_Host(void)
+{
+    uint16 length;
+
+    if ((simSent >= simStreamLen) || (0u != simOutFull))
+    {
+        return;
+    }
+    #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+        if ((0u == simArmed) || (NULL == simLanding))
+        {
+            return;
+        }
+    #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+    length = (0u != simFullOnly) ? SIM_PACKET : (uint16)(Sim_Rand() % (SIM_PACKET + 1u));
+    if (length > (simStreamLen - simSent))
+    {
+        length = (uint16)(simStreamLen - simSent);
+    }
+
+    #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+        (void)memcpy(simLanding, &simStream[simSent], length);
+        simArmed = 0u;
+    #else
+        (void)memcpy(simOut, &simStream[simSent], length);
+    #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+    simOutCount = length;
+    simOutFull = 1u;
+    simSent += length;
+}
+
+uint8 USBUART_DataIsReady(void)
+{
+    return simOutFull;
+}
+
+uint16 USBUART_GetCount(void)
+{
+    return (0u != simOutFull) ? simOutCount : 0u;
+}
+
+uint16 USBUART_GetData(uint8 *pData, uint16 length)
+{
+    if (length > simOutCount)
+    {
+        length = simOutCount;
+    }
+    (void)memcpy(pData, simOut, length);
+    simCpuCopies += length;
+    // reading re-arms the endpoint
+    simOutFull = 0u;
+    return length;
+}
+
+uint16 USBUART_ReadOutEP(uint8 epNumber, uint8 pData[], uint16 length)
+{
+    (void)epNumber;
+    simLanding = pData;
+    simArmed = 1u;
+    return length;
+}
+
+void USBUART_EnableOutEP(uint8 epNumber)
+{
+    (void)epNumber;
+    if (simReleased != simSent)
+    {
+        simEarlyArms++;
+    }
+    simOutFull = 0u;
+    simArmed = 1u;
+}
+
+// ep_copy_host.c links it; nothing is sent in this test
+void USBUART_PutData(const uint8 *pData, uint16 length)
+{
+    (void)pData;
+    (void)length;
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-56s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+static void Sim_Start(uint32 length)
+{
+    uint32 i;
+
+    simStreamLen = length;
+    simSent = 0u;
+    simOutFull = 0u;
+    simArmed = 1u;
+    simLanding = NULL;
+    simCpuCopies = 0u;
+    simReleased = 0u;
+    for (i = 0u; i < length; i++)
+    {
+        simStream[i] = (uint8)Sim_Rand();
+    }
+    CdcRx_Init();
+    CdcRx_Start();
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8 buffer[CDC_RX_RING_SIZE];
+    static uint8 held[CDC_RX_RING_SIZE];
+    uint32 kilobytes = SIM_DEFAULT_KB;
+    uint32 got = 0u;
+    uint32 borrows = 0u;
+    uint32 holds = 0u;
+    uint32 reads = 0u;
+    uint32 copies;
+    uint8 inOrder = 1u;
+    uint8 heldStill = 1u;
+#if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+    uint8 inPlace = 1u;
+#else
+    uint8 armedEarly = 1u;
+#endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+    uint8 failed = 0u;
+    const uint8 *data;
+    uint16 length;
+    uint16 count;
+    uint16 taken;
+    uint32 passes;
+    uint32 i;
+
+    if (argc > 1)
+    {
+        kilobytes = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        simState = strtoull(argv[2], NULL, 0) | 1u;
+    }
+    if (0u == kilobytes)
+    {
+        kilobytes = 1u;
+    }
+
+    simStream = malloc((size_t)kilobytes * 1024u);
+    if (NULL == simStream)
+    {
+        return 1;
+    }
+
+    printf("%u KB in packets of 0..64 bytes, endpoint mode %u\n\n", kilobytes, (uint32)USBUART_EP_MM);
+
+    // a lost packet would stall the stream, give up after plenty of passes
+    Sim_Start(kilobytes * 1024u);
+    for (passes = 0u; (got < simStreamLen) && (passes < (16u * simStreamLen)); passes++)
+    {
+        Sim_Host();
+        taken = CdcRx_Service();
+        #if (!USBUART_EP_MANAGEMENT_DMA_AUTO)
+            // manual mode re-arms once the packet is in the ring
+            if ((0u != taken) && (0u != simOutFull))
+            {
+                armedEarly = 0u;
+            }
+        #else
+            (void)taken;
+        #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+        switch (Sim_Rand() % 8u)
+        {
+            case 0u:
+                // read with a copy instead, the re-arm is not checked
+                simReleased = simSent;
+                count = CdcRx_Read(buffer, (uint16)(1u + (Sim_Rand() % sizeof(buffer))));
+                inOrder &= (0 == memcmp(buffer, &simStream[got], count)) ? 1u : 0u;
+                got += count;
+                reads++;
+                break;
+
+            case 1u:
+                // hold a borrow while more packets come in
+                data = CdcRx_Borrow(&length);
+                if (NULL == data)
+                {
+                    break;
+                }
+                (void)memcpy(held, data, length);
+                for (i = 0u; i < 4u; i++)
+                {
+                    Sim_Host();
+                    (void)CdcRx_Service();
+                }
+                heldStill &= (0 == memcmp(held, data, length)) ? 1u : 0u;
+                inOrder &= (0 == memcmp(data, &simStream[got], length)) ? 1u : 0u;
+                simReleased = got + length;
+                CdcRx_Release(length);
+                got += length;
+                holds++;
+                break;
+
+            default:
+                // release a random part of what was borrowed
+                data = CdcRx_Borrow(&length);
+                if (NULL == data)
+                {
+                    break;
+                }
+                #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+                    inPlace &= ((data >= simLanding) && (&data[length] <= &simLanding[SIM_PACKET])) ? 1u : 0u;
+                #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+                count = (uint16)(1u + (Sim_Rand() % length));
+                inOrder &= (0 == memcmp(data, &simStream[got], count)) ? 1u : 0u;
+                simReleased = got + count;
+                CdcRx_Release(count);
+                got += count;
+                borrows++;
+                break;
+        }
+    }
+
+    printf("%u borrows, %u held over new packets, %u reads\n\n", borrows, holds, reads);
+    failed |= Sim_Check(inOrder && (got == simStreamLen) && (0u == CdcRx_Count()), "every byte arrives once and in order");
+    failed |= Sim_Check(heldStill, "borrowed bytes stay put until released");
+    #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+        failed |= Sim_Check(inPlace, "borrows point into the endpoint DMA buffer");
+        failed |= Sim_Check(0u == simEarlyArms, "endpoint re-armed only after the packet is released");
+        failed |= Sim_Check(0u == simCpuCopies, "the CPU never reads the endpoint");
+    #else
+        failed |= Sim_Check(armedEarly, "endpoint re-armed as soon as the packet is in the ring");
+    #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+    // bytes copied by the CPU for a stream of full packets
+    printf("\nCPU bytes copied per byte received, %u bytes in 64-byte packets\n", SIM_COPY_BYTES);
+    simFullOnly = 1u;
+    for (i = 0u; i < 2u; i++)
+    {
+        Sim_Start(SIM_COPY_BYTES);
+        copies = 0u;
+        got = 0u;
+        for (passes = 0u; (got < simStreamLen) && (passes < (16u * simStreamLen)); passes++)
+        {
+            Sim_Host();
+            (void)CdcRx_Service();
+            simReleased = simSent;
+            if (0u == i)
+            {
+                count = CdcRx_Read(buffer, SIM_PACKET);
+                copies += count;
+            }
+            else
+            {
+                data = CdcRx_Borrow(&count);
+                if (NULL != data)
+                {
+                    CdcRx_Release(count);
+                }
+            }
+            got += count;
+        }
+        copies += simCpuCopies;
+        printf("  %-8s %.2f\n", (0u == i) ? "read" : "borrow", (double)copies / (double)simStreamLen);
+    }
+
+    free(simStream);
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,448 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host benchmark of the lock's echo path on a model of a full-speed bus.
+ * The host writes a bulk stream in 64-byte OUT packets and reads the echo
+ * back with IN transactions. OUT and IN take turns on the bus, a NAKed
+ * transaction still costs bus time, and a transaction has to fit in the
+ * 1 ms frame it starts in. Each endpoint holds one packet, like the SIE.
+ *
+ * The firmware side runs cdc_rx.c (and cdc_tx.c) as built for the target.
+ * Every component call and every byte copied costs CPU time, so a loop
+ * spinning on USBUART_CDCIsReady() lets the bus run while it waits.
+ * Three echo paths are compared on the same input:
+ *
+ *   byte   USBUART_PutChar() per byte after waiting for the endpoint, as
+ *          the original main.c did
+ *   chunk  one USBUART_PutData() per chunk read, plus a ZLP after a full
+ *          one, waiting for the endpoint each time (the loop before cdc_tx)
+ *   tx     CdcTx_Write() and CdcTx_Service(), never waiting
+ *
+ * The costs below are estimates for a 24 MHz PSoC 5LP in manual endpoint
+ * mode, not measurements; the ratios matter more than the absolute KB/s.
+ * It also checks that every byte comes back in order and that the host's
+ * last read completes, i.e. an exact multiple of 64 ends in a ZLP.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn cdc_tx_bench.c ep_copy_host.c \
+ *       ../combintional_lock.cydsn/cdc_rx.c ../combintional_lock.cydsn/cdc_tx.c \
+ *       -o cdc_tx_bench
+ *   ./cdc_tx_bench [kilobytes]
+ *
+ * Add -DUSBUART_EP_MM=2 for DMA with Automatic Buffer Management: OUT
+ * packets land in the buffer CdcRx_Start() armed, and an IN packet is only
+ * read from its source when the host takes it, so a ring that reused the
+ * bytes too early would show up as corrupted echo. Copies through the
+ * endpoint then cost no CPU time. Only the tx path runs in that build, the
+ * other two were written for manual mode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "cdc_rx.h"
+#include "cdc_tx.h"
+
+#define SIM_PACKET          (64u)
+
+// bus, in ns; one byte is 8 bits at 12 Mbit/s
+#define SIM_BYTE_NS         (667u)
+#define SIM_FRAME_NS        (1000000u)
+#define SIM_SOF_NS          (6u * SIM_BYTE_NS)
+#define SIM_DATA_NS(n)      (((n) + 14u) * SIM_BYTE_NS)    // token, data, handshake, gaps
+#define SIM_NAK_NS          (8u * SIM_BYTE_NS)
+
+// firmware, in ns
+#define SIM_CALL_NS         (1000u)     // a USBUART call that touches the SIE
+#define SIM_EP_BYTE_NS      (250u)      // byte loop through arbEp[].rwDr
+#define SIM_COPY_BYTE_NS    (50u)       // memcpy within RAM
+#define SIM_LOOP_NS         (1000u)     // rest of a main loop pass
+
+typedef enum
+{
+    SIM_ECHO_BYTE = 0,
+    SIM_ECHO_CHUNK,
+    SIM_ECHO_TX,
+    SIM_ECHO_COUNT
+} sim_echo_t;
+
+static const char *const simEchoNames[SIM_ECHO_COUNT] = { "byte", "chunk", "tx" };
+
+#if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+    #define SIM_ECHO_FIRST  (SIM_ECHO_TX)
+    #define SIM_CPU_BYTE_NS (0u)            // the endpoint DMA moves the bytes
+#else
+    #define SIM_ECHO_FIRST  (SIM_ECHO_BYTE)
+    #define SIM_CPU_BYTE_NS (SIM_EP_BYTE_NS)
+#endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+
+static uint64 simNs = 0u;
+static uint64 simBusNs = 0u;        // the bus is busy until then
+static uint8 simBusTurn = 0u;       // 0: OUT next, 1: IN next
+
+// OUT endpoint and the host's stream
+static uint8 simOut[SIM_PACKET];
+static uint16 simOutCount = 0u;
+static uint8 simOutFull = 0u;
+static uint8 *simLanding = NULL;    // DMA auto: where OUT packets are written
+static uint8 *simStream;
+static uint32 simStreamLen = 0u;
+static uint32 simSent = 0u;
+
+// IN endpoint and what the host read
+static uint8 simIn[SIM_PACKET];
+static uint16 simInCount = 0u;
+static uint8 simInFull = 0u;
+static const uint8 *simInSource = NULL; // DMA auto: read when the host takes the packet
+static uint8 *simEcho;
+static uint32 simEchoLen = 0u;
+static uint32 simInPackets = 0u;
+static uint32 simInZlps = 0u;
+static uint8 simReadOpen = 0u;      // the host's read has data but no short packet yet
+static uint64 simLastNs = 0u;       // when the last echoed byte reached the host
+
+// Runs the host side of the bus until now + ns.
+static void Sim_Spend(uint64 ns)
+{
+    uint64 end = simNs + ns;
+    uint64 frame;
+    uint64 cost;
+    uint16 length;
+
+    while (simBusNs <= end)
+    {
+        frame = simBusNs - (simBusNs % SIM_FRAME_NS);
+        if (simBusNs == frame)
+        {
+            simBusNs += SIM_SOF_NS;
+            continue;
+        }
+
+        if (0u == simBusTurn)
+        {
+            length = (simSent < simStreamLen) ? SIM_PACKET : 0u;
+            if (length > (simStreamLen - simSent))
+            {
+                length = (uint16)(simStreamLen - simSent);
+            }
+            cost = (0u == length) ? 0u : ((0u != simOutFull) ? SIM_NAK_NS : SIM_DATA_NS(length));
+        }
+        else
+        {
+            cost = (0u != simInFull) ? SIM_DATA_NS(simInCount) : SIM_NAK_NS;
+        }
+
+        if ((simBusNs + cost) > (frame + SIM_FRAME_NS))
+        {
+            // does not fit in what is left of the frame
+            simBusNs = frame + SIM_FRAME_NS;
+            continue;
+        }
+
+        if (0u == simBusTurn)
+        {
+            if ((0u != length) && (0u == simOutFull))
+            {
+                (void)memcpy(simOut, &simStream[simSent], length);
+                if (NULL != simLanding)
+                {
+                    (void)memcpy(simLanding, simOut, length);
+                }
+                simOutCount = length;
+                simOutFull = 1u;
+                simSent += length;
+            }
+        }
+        else if (0u != simInFull)
+        {
+            if (NULL != simInSource)
+            {
+                (void)memcpy(simIn, simInSource, simInCount);
+            }
+            (void)memcpy(&simEcho[simEchoLen], simIn, simInCount);
+            simEchoLen += simInCount;
+            simInPackets++;
+            simInZlps += (0u == simInCount) ? 1u : 0u;
+            simReadOpen = (SIM_PACKET == simInCount) ? 1u : 0u;
+            simInFull = 0u;
+            simLastNs = simBusNs + cost;
+        }
+        simBusNs += (0u == cost) ? SIM_NAK_NS : cost;
+        simBusTurn ^= 1u;
+    }
+
+    simNs = end;
+}
+
+uint8 USBUART_DataIsReady(void)
+{
+    Sim_Spend(SIM_CALL_NS);
+    return simOutFull;
+}
+
+uint16 USBUART_GetCount(void)
+{
+    Sim_Spend(SIM_CALL_NS);
+    return (0u != simOutFull) ? simOutCount : 0u;
+}
+
+uint16 USBUART_GetData(uint8 *pData, uint16 length)
+{
+    if (length > simOutCount)
+    {
+        length = simOutCount;
+    }
+    Sim_Spend(SIM_CALL_NS + ((uint64)length * SIM_CPU_BYTE_NS));
+    (void)memcpy(pData, simOut, length);
+    simOutFull = 0u;
+    return length;
+}
+
+uint16 USBUART_GetAll(uint8 *pData)
+{
+    return USBUART_GetData(pData, SIM_PACKET);
+}
+
+uint8 USBUART_CDCIsReady(void)
+{
+    Sim_Spend(SIM_CALL_NS);
+    return (0u == simInFull) ? 1u : 0u;
+}
+
+void USBUART_PutData(const uint8 *pData, uint16 length)
+{
+    #if (USBUART_EP_MANAGEMENT_DMA_AUTO)
+        Sim_Spend(SIM_CALL_NS);
+        if (NULL != pData)
+        {
+            // only sets up the DMA
+            simInSource = pData;
+            return;
+        }
+    #else
+        Sim_Spend(SIM_CALL_NS + ((uint64)length * SIM_EP_BYTE_NS));
+        if (0u != length)
+        {
+            (void)memcpy(simIn, pData, length);
+        }
+    #endif /* USBUART_EP_MANAGEMENT_DMA_AUTO */
+    simInCount = length;
+    simInFull = 1u;
+}
+
+uint16 USBUART_ReadOutEP(uint8 epNumber, uint8 pData[], uint16 length)
+{
+    (void)epNumber;
+    Sim_Spend(SIM_CALL_NS);
+    simLanding = pData;
+    return length;
+}
+
+void USBUART_EnableOutEP(uint8 epNumber)
+{
+    (void)epNumber;
+    Sim_Spend(SIM_CALL_NS);
+    simOutFull = 0u;
+}
+
+void USBUART_PutChar(char8 txDataByte)
+{
+    static uint8 data;      // outlives the call like the generated one
+
+    data = (uint8)txDataByte;
+    USBUART_PutData(&data, 1u);
+}
+
+// One pass of the firmware loop with the given echo path.
+static void Sim_Loop(sim_echo_t echo)
+{
+    uint8 buffer[SIM_PACKET];
+    uint16 count;
+    uint16 room = SIM_PACKET;
+    uint16 i;
+
+    Sim_Spend(SIM_LOOP_NS);
+    (void)CdcRx_Service();
+    if (SIM_ECHO_TX == echo)
+    {
+        room = CdcTx_Free();
+        if (room > SIM_PACKET)
+        {
+            room = SIM_PACKET;
+        }
+    }
+    count = CdcRx_Read(buffer, room);
+    Sim_Spend((uint64)count * SIM_COPY_BYTE_NS);
+
+    switch (echo)
+    {
+        case SIM_ECHO_BYTE:
+            for (i = 0u; i < count; i++)
+            {
+                while (0u == USBUART_CDCIsReady())
+                {
+                }
+                USBUART_PutChar((char8)buffer[i]);
+            }
+            break;
+
+        case SIM_ECHO_CHUNK:
+            if (0u != count)
+            {
+                while (0u == USBUART_CDCIsReady())
+                {
+                }
+                USBUART_PutData(buffer, count);
+                if (SIM_PACKET == count)
+                {
+                    while (0u == USBUART_CDCIsReady())
+                    {
+                    }
+                    USBUART_PutData(NULL, 0u);
+                }
+            }
+            break;
+
+        default:
+            if (0u != count)
+            {
+                (void)CdcTx_Write(buffer, count);
+                Sim_Spend((uint64)count * SIM_COPY_BYTE_NS);
+            }
+            (void)CdcTx_Service((uint32)(simNs / 1000000u));
+            break;
+    }
+}
+
+static void Sim_Reset(uint32 size)
+{
+    simNs = 0u;
+    simBusNs = 0u;
+    simBusTurn = 0u;
+    simOutFull = 0u;
+    simInFull = 0u;
+    simSent = 0u;
+    simEchoLen = 0u;
+    simInPackets = 0u;
+    simInZlps = 0u;
+    simReadOpen = 0u;
+    simLastNs = 0u;
+    simStreamLen = size;
+    simLanding = NULL;
+    simInSource = NULL;
+    CdcRx_Init();
+    CdcRx_Start();
+    CdcTx_Init();
+}
+
+// Echoes size bytes through the given path, returns the echoed KB/s.
+static double Sim_Run(sim_echo_t echo, uint32 size, uint8 *ok)
+{
+    uint32 i;
+
+    for (i = 0u; i < size; i++)
+    {
+        simStream[i] = (uint8)(i * 7u);
+    }
+    Sim_Reset(size);
+
+    // until the echo is in and the host's read has completed
+    while (((simEchoLen < size) || (0u != simReadOpen) || (0u != simInFull)) &&
+        (simNs < (60ull * 1000000000ull)))
+    {
+        Sim_Loop(echo);
+    }
+
+    *ok = ((simEchoLen == size) && (0 == memcmp(simEcho, simStream, size))) ? 1u : 0u;
+    return ((double)size / 1024.0) / ((double)simLastNs * 1e-9);
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-52s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 size = 256u << 10u;
+    uint32 echo;
+    uint8 failed = 0u;
+    uint8 ok;
+    double rate;
+    cdc_tx_stats_t stats;
+
+    if (argc > 1)
+    {
+        size = (uint32)strtoul(argv[1], NULL, 0) << 10u;
+    }
+    if (size < SIM_PACKET)
+    {
+        size = SIM_PACKET;
+    }
+    simStream = (uint8 *)malloc(size);
+    simEcho = (uint8 *)malloc(size);
+
+    printf("%u bytes echoed, endpoint mode %u\n\n", size, (uint32)USBUART_EP_MM);
+    printf("%-6s %10s %10s %8s %10s\n", "echo", "KB/s", "IN pkts", "ZLPs", "bytes/pkt");
+    for (echo = SIM_ECHO_FIRST; echo < SIM_ECHO_COUNT; echo++)
+    {
+        rate = Sim_Run((sim_echo_t)echo, size, &ok);
+        printf("%-6s %10.1f %10u %8u %10.1f%s\n", simEchoNames[echo], rate, simInPackets, simInZlps,
+            (double)simEchoLen / (double)(simInPackets - simInZlps), (0u != ok) ? "" : "  LOST DATA");
+        failed |= (0u != ok) ? 0u : 1u;
+    }
+    printf("\n");
+
+    // exact multiples end in a ZLP, anything else in a short packet
+    (void)Sim_Run(SIM_ECHO_TX, 2u * SIM_PACKET, &ok);
+    failed |= Sim_Check((0u != ok) && (3u == simInPackets) && (1u == simInZlps),
+        "128 bytes go out as 64 + 64 + ZLP");
+    (void)Sim_Run(SIM_ECHO_TX, 100u, &ok);
+    failed |= Sim_Check((0u != ok) && (2u == simInPackets) && (0u == simInZlps),
+        "100 bytes go out as 64 + 36");
+
+    // a packet still in the endpoint keeps its bytes in the ring
+    Sim_Reset(0u);
+    (void)memset(simStream, 'A', CDC_TX_RING_SIZE);
+    (void)CdcTx_Write(simStream, CDC_TX_RING_SIZE);
+    (void)CdcTx_Service(0u);
+    (void)memset(simStream, 'B', SIM_PACKET);
+    (void)CdcTx_Write(simStream, SIM_PACKET);
+    while (0u != simInFull)
+    {
+        Sim_Spend(SIM_CALL_NS);
+    }
+    (void)memset(simStream, 'A', SIM_PACKET);
+    failed |= Sim_Check((SIM_PACKET == simEchoLen) && (0 == memcmp(simEcho, simStream, SIM_PACKET)),
+        "bytes in flight are not reused");
+
+    // back-pressure: nothing is serviced, the ring fills and says so
+    CdcTx_Init();
+    (void)memset(simStream, 0, SIM_PACKET);
+    for (echo = 0u; echo < ((CDC_TX_RING_SIZE / SIM_PACKET) + 1u); echo++)
+    {
+        (void)CdcTx_Write(simStream, SIM_PACKET);
+    }
+    CdcTx_GetStats(&stats);
+    failed |= Sim_Check((0u == CdcTx_Free()) && (SIM_PACKET == stats.refused) &&
+        (0u == CdcTx_Write(simStream, 1u)), "a full ring refuses writes");
+
+    free(simStream);
+    free(simEcho);
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
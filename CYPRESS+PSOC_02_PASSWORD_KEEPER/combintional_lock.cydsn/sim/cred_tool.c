@@ -0,0 +1,413 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Builds the lock's credential table and benchmarks lookups, with the
+ * firmware's own cred.c.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn cred_tool.c \
+ *       ../combintional_lock.cydsn/cred.c -o cred_tool
+ *
+ *   ./cred_tool gen credentials.csv [32 hex digit salt] > ../combintional_lock.cydsn/cred_table.c
+ *       CSV lines are "user,code", user 0..65534, code up to CRED_MAX_LEN
+ *       characters without '#'; lines starting with ';' are comments.
+ *       Without a salt one is read from /dev/urandom. If a code cannot be
+ *       placed within its probe window the tool draws a new salt anyway.
+ *       The table is written with CRLF line endings, as the firmware
+ *       sources are.
+ *
+ *   ./cred_tool bench [lookups]
+ *       Tables of 10, 1,000 and 10,000 random codes; every code must find
+ *       its user and random other codes must not. Reports attempts per
+ *       second for hits and misses, each a whole "code#" through
+ *       Cred_Push() as the firmware runs it.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cytypes.h"
+#include "cred.h"
+
+#define TOOL_MAX_USERS      (65535u)
+#define TOOL_SALT_TRIES     (64u)
+#define TOOL_DEFAULT_LOOKUPS (2000000u)
+
+typedef struct
+{
+    uint16 user;
+    uint8 length;
+    char8 code[CRED_MAX_LEN + 1u];
+} tool_user_t;
+
+static uint64 toolState = 0x6A09E667F3BCC908ull;
+
+static uint32 Tool_Rand(void)
+{
+    toolState ^= toolState >> 12u;
+    toolState ^= toolState << 25u;
+    toolState ^= toolState >> 27u;
+    return (uint32)((toolState * 2685821657736338717ull) >> 32u);
+}
+
+static double Tool_Seconds(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+// SipHash-2-4 reference vector: key 00..0f, empty message
+static uint8 Tool_CheckSipHash(void)
+{
+    static const cred_entry_t none[CRED_PROBE_WINDOW];
+    cred_table_t table = { { 0x03020100u, 0x07060504u, 0x0B0A0908u, 0x0F0E0D0Cu }, CRED_PROBE_WINDOW, 0u, none };
+    uint8 message[15];
+    uint8 i;
+
+    for (i = 0u; i < sizeof(message); i++)
+    {
+        message[i] = i;
+    }
+    return ((0x726FDB47DD0E0E31ull == Cred_Digest(&table, message, 0u)) &&
+            (0xA129CA6149BE45E5ull == Cred_Digest(&table, message, 15u))) ? 1u : 0u;
+}
+
+/*
+ * Fills the table with the users by Robin Hood insertion: a code that has
+ * come further from its home slot than the one in its way takes the slot.
+ * Starts at a load of at most one half and tries new salts, then twice the
+ * slots, until every code is within CRED_PROBE_WINDOW of home. Returns the
+ * entries, NULL if two users share a code.
+ */
+static cred_entry_t *Tool_Build(cred_table_t *table, const tool_user_t *users, uint32 count)
+{
+    cred_entry_t *entries = NULL;
+    cred_entry_t moving;
+    cred_entry_t swap;
+    uint32 slots = CRED_PROBE_WINDOW;
+    uint32 tries = 0u;
+    uint32 mask;
+    uint32 pos;
+    uint32 distance;
+    uint32 held;
+    uint32 i;
+    uint64 digest;
+    uint8 failed;
+
+    while (slots < (2u * count))
+    {
+        slots <<= 1u;
+    }
+
+    for (;;)
+    {
+        entries = (cred_entry_t *)realloc(entries, slots * sizeof(cred_entry_t));
+        for (i = 0u; i < slots; i++)
+        {
+            entries[i].digestLo = CRED_EMPTY;
+            entries[i].digestHi = CRED_EMPTY;
+            entries[i].user = CRED_NO_USER;
+            entries[i].reserved = 0u;
+        }
+        table->slots = slots;
+        table->users = count;
+        table->entries = entries;
+        mask = slots - 1u;
+
+        failed = 0u;
+        for (i = 0u; (i < count) && (0u == failed); i++)
+        {
+            digest = Cred_Digest(table, (const uint8 *)users[i].code, users[i].length);
+            if (CRED_NO_USER != Cred_Lookup(table, digest))
+            {
+                free(entries);
+                return NULL;
+            }
+
+            moving.digestLo = (uint32)digest;
+            moving.digestHi = (uint32)(digest >> 32u);
+            moving.user = users[i].user;
+            moving.reserved = 0u;
+            failed = ((CRED_EMPTY == moving.digestLo) && (CRED_EMPTY == moving.digestHi)) ? 1u : 0u;
+
+            pos = moving.digestLo & mask;
+            distance = 0u;
+            while ((0u == failed) && (CRED_NO_USER != entries[pos].user))
+            {
+                held = (pos - entries[pos].digestLo) & mask;
+                if (held < distance)
+                {
+                    swap = entries[pos];
+                    entries[pos] = moving;
+                    moving = swap;
+                    distance = held;
+                }
+                pos = (pos + 1u) & mask;
+                distance++;
+                failed = (distance >= CRED_PROBE_WINDOW) ? 1u : 0u;
+            }
+            if (0u == failed)
+            {
+                entries[pos] = moving;
+            }
+        }
+        if (0u == failed)
+        {
+            return entries;
+        }
+
+        // another salt, and more room after a few
+        tries++;
+        if (tries >= TOOL_SALT_TRIES)
+        {
+            slots <<= 1u;
+            tries = 0u;
+        }
+        for (i = 0u; i < 4u; i++)
+        {
+            table->key[i] = Tool_Rand();
+        }
+    }
+}
+
+// printf() for the generated source, with the firmware's CRLF line endings
+static void Tool_Emit(const char *format, ...)
+{
+    char text[512];
+    va_list args;
+    char *c;
+
+    va_start(args, format);
+    (void)vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    for (c = text; '\0' != *c; c++)
+    {
+        if ('\n' == *c)
+        {
+            (void)putchar('\r');
+        }
+        (void)putchar(*c);
+    }
+}
+
+static int Tool_Generate(const char *csv, const char *saltText)
+{
+    static tool_user_t users[TOOL_MAX_USERS];
+    cred_table_t table;
+    cred_entry_t *entries;
+    char line[128];
+    char hex[9];
+    unsigned long user;
+    uint32 count = 0u;
+    uint32 i;
+    char *code;
+    char *end;
+    FILE *file = fopen(csv, "r");
+    FILE *random;
+
+    if (NULL == file)
+    {
+        fprintf(stderr, "cannot open %s\n", csv);
+        return 1;
+    }
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if ((';' == line[0]) || ('\0' == line[0]))
+        {
+            continue;
+        }
+        user = strtoul(line, &end, 0);
+        code = (',' == *end) ? (end + 1) : NULL;
+        if ((NULL == code) || (user >= CRED_NO_USER) || ('\0' == code[0]) ||
+            (strlen(code) > CRED_MAX_LEN) || (NULL != strchr(code, CRED_TERMINATOR)) ||
+            (count >= TOOL_MAX_USERS))
+        {
+            fprintf(stderr, "bad line: %s\n", line);
+            fclose(file);
+            return 1;
+        }
+        users[count].user = (uint16)user;
+        users[count].length = (uint8)strlen(code);
+        (void)strcpy(users[count].code, code);
+        count++;
+    }
+    fclose(file);
+
+    if ((NULL != saltText) && (32u == strlen(saltText)))
+    {
+        for (i = 0u; i < 4u; i++)
+        {
+            (void)memcpy(hex, &saltText[i * 8u], 8u);
+            hex[8] = '\0';
+            table.key[i] = (uint32)strtoul(hex, NULL, 16);
+        }
+    }
+    else
+    {
+        random = fopen("/dev/urandom", "rb");
+        if ((NULL == random) || (1u != fread(table.key, sizeof(table.key), 1u, random)))
+        {
+            fprintf(stderr, "no salt\n");
+            return 1;
+        }
+        fclose(random);
+    }
+
+    entries = Tool_Build(&table, users, count);
+    if (NULL == entries)
+    {
+        fprintf(stderr, "two users share a code\n");
+        return 1;
+    }
+
+    Tool_Emit("/* ========================================\n *\n * Copyright YOUR COMPANY, THE YEAR\n"
+        " * All Rights Reserved\n * UNPUBLISHED, LICENSED SOFTWARE.\n *\n"
+        " * CONFIDENTIAL AND PROPRIETARY INFORMATION\n * WHICH IS THE PROPERTY OF your company.\n"
+        " *\n * ========================================\n*/\n\n");
+    Tool_Emit("/*\n * Generated by sim/cred_tool.c from %s, do not edit.\n"
+        " * %u users in %u slots, %u bytes of flash.\n */\n\n",
+        csv, count, table.slots, (uint32)(table.slots * sizeof(cred_entry_t)));
+    Tool_Emit("#include \"cred.h\"\n\n");
+    Tool_Emit("static const cred_entry_t credEntries[%uu] =\n{\n", table.slots);
+    for (i = 0u; i < table.slots; i++)
+    {
+        Tool_Emit("    { 0x%08Xu, 0x%08Xu, 0x%04Xu, 0u },\n", entries[i].digestLo, entries[i].digestHi,
+            (uint32)entries[i].user);
+    }
+    Tool_Emit("};\n\nconst cred_table_t Cred_table =\n{\n");
+    Tool_Emit("    { 0x%08Xu, 0x%08Xu, 0x%08Xu, 0x%08Xu },\n", table.key[0], table.key[1], table.key[2], table.key[3]);
+    Tool_Emit("    %uu,\n    %uu,\n    credEntries\n};\n\n/* [] END OF FILE */\n", table.slots, count);
+
+    free(entries);
+    return 0;
+}
+
+static double Tool_Time(cred_attempt_t *attempt, const uint8 *stream, uint32 size, uint32 *accepted)
+{
+    double start = Tool_Seconds();
+    uint32 pos;
+    uint16 used;
+    uint16 chunk;
+
+    *accepted = 0u;
+    for (pos = 0u; pos < size; pos += used)
+    {
+        chunk = (uint16)(((size - pos) > 64u) ? 64u : (size - pos));
+        *accepted += (CRED_ACCEPT == Cred_Push(attempt, &stream[pos], chunk, &used)) ? 1u : 0u;
+    }
+    return Tool_Seconds() - start;
+}
+
+static int Tool_Bench(uint32 lookups)
+{
+    static const uint32 sizes[] = { 10u, 1000u, 10000u };
+    static tool_user_t users[10000];
+    cred_table_t table = { { 0x1F83D9ABu, 0xFB41BD6Bu, 0x5BE0CD19u, 0x137E2179u }, 0u, 0u, NULL };
+    cred_attempt_t attempt;
+    cred_entry_t *entries;
+    uint8 *hits = (uint8 *)malloc(lookups * 9u);
+    uint8 *misses = (uint8 *)malloc(lookups * 9u);
+    uint32 hitSize;
+    uint32 missSize;
+    uint32 accepted;
+    uint32 rejectedMisses;
+    uint8 failed = 0u;
+    double hitTime;
+    double missTime;
+    uint32 n;
+    uint32 i;
+    uint32 k;
+    uint32 pick;
+
+    failed |= (0u == Tool_CheckSipHash()) ? 1u : 0u;
+    printf("SipHash-2-4 reference vectors: %s\n\n", (0u == failed) ? "ok" : "FAILED");
+    printf("%8s %8s %10s %12s %12s\n", "users", "slots", "flash B", "hits/s", "misses/s");
+
+    for (n = 0u; n < (sizeof(sizes) / sizeof(sizes[0])); n++)
+    {
+        // distinct 8-digit codes, "1xxxxxxx" for users and "2xxxxxxx" for misses
+        for (i = 0u; i < sizes[n]; i++)
+        {
+            users[i].user = (uint16)i;
+            users[i].length = 8u;
+            (void)snprintf(users[i].code, sizeof(users[i].code), "1%07u", (i * 7919u) % 10000000u);
+        }
+        entries = Tool_Build(&table, users, sizes[n]);
+        if (NULL == entries)
+        {
+            return 1;
+        }
+
+        hitSize = 0u;
+        missSize = 0u;
+        for (i = 0u; i < lookups; i++)
+        {
+            pick = Tool_Rand() % sizes[n];
+            (void)memcpy(&hits[hitSize], users[pick].code, 8u);
+            hits[hitSize + 8u] = CRED_TERMINATOR;
+            hitSize += 9u;
+            misses[missSize] = '2';
+            for (k = 1u; k < 8u; k++)
+            {
+                misses[missSize + k] = (uint8)('0' + (Tool_Rand() % 10u));
+            }
+            misses[missSize + 8u] = CRED_TERMINATOR;
+            missSize += 9u;
+        }
+
+        Cred_Begin(&attempt, &table);
+        hitTime = Tool_Time(&attempt, hits, hitSize, &accepted);
+        missTime = Tool_Time(&attempt, misses, missSize, &rejectedMisses);
+        failed |= ((accepted != lookups) || (0u != rejectedMisses)) ? 1u : 0u;
+
+        // every user once, with the right id
+        for (i = 0u; i < sizes[n]; i++)
+        {
+            failed |= (users[i].user != Cred_Lookup(&table,
+                Cred_Digest(&table, (const uint8 *)users[i].code, 8u))) ? 1u : 0u;
+        }
+
+        printf("%8u %8u %10u %12.0f %12.0f\n", sizes[n], table.slots,
+            (uint32)(table.slots * sizeof(cred_entry_t)),
+            (double)lookups / hitTime, (double)lookups / missTime);
+        free(entries);
+    }
+
+    printf("\nall users found, no false accepts: %s\n", (0u == failed) ? "ok" : "FAILED");
+    free(hits);
+    free(misses);
+    return (0u == failed) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if ((argc > 2) && (0 == strcmp(argv[1], "gen")))
+    {
+        return Tool_Generate(argv[2], (argc > 3) ? argv[3] : NULL);
+    }
+    if ((argc > 1) && (0 == strcmp(argv[1], "bench")))
+    {
+        return Tool_Bench((argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : TOOL_DEFAULT_LOOKUPS);
+    }
+
+    fprintf(stderr, "usage: %s gen <csv> [salt] | bench [lookups]\n", argv[0]);
+    return 2;
+}
+
+/* [] END OF FILE */
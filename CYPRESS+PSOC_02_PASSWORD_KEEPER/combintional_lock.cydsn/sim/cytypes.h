@@ -0,0 +1,40 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef CY_BOOT_CYTYPES_H
+#define CY_BOOT_CYTYPES_H
+
+/*
+ * Host stand-in for Generated_Source/PSoC5/cytypes.h. The generated one
+ * maps uint32 to unsigned long, which is 64 bits on a 64-bit PC, so the
+ * portable modules are built against these fixed-width types instead.
+ */
+
+#include <stdint.h>
+
+typedef uint8_t     uint8;
+typedef uint16_t    uint16;
+typedef uint32_t    uint32;
+typedef uint64_t    uint64;
+typedef int8_t      int8;
+typedef int16_t     int16;
+typedef int32_t     int32;
+typedef char        char8;
+
+#define CYCODE
+#define CY_INLINE   inline
+
+#define CY_ISR(FuncName)        void FuncName (void)
+#define CY_ISR_PROTO(FuncName)  void FuncName (void)
+typedef void (* cyisraddress)(void);
+
+#endif /* CY_BOOT_CYTYPES_H */
+/* [] END OF FILE */
@@ -0,0 +1,54 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host stand-in for ep_copy.c, which needs the USB arbiter registers. The
+ * CDC data endpoints are the only ones the lock uses, so the copies go to
+ * the USBUART_PutData()/USBUART_GetData() models of the test they are
+ * linked with; only the endpoint numbers are checked here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "ep_copy.h"
+
+volatile uint8 USBUART_cdcDataInEp[2] = { 1u, 0u };
+volatile uint8 USBUART_cdcDataOutEp[2] = { 2u, 0u };
+
+void EpCopy_Init(void)
+{
+}
+
+void EpCopy_LoadInEP(uint8 epNumber, const uint8 data[], uint16 length)
+{
+    if (USBUART_cdcDataInEp[USBUART_COM_PORT1] != epNumber)
+    {
+        printf("EpCopy_LoadInEP() on endpoint %u\n", epNumber);
+        exit(1);
+    }
+    USBUART_PutData(data, length);
+}
+
+uint16 EpCopy_ReadOutEP(uint8 epNumber, uint8 data[], uint16 length)
+{
+    if (USBUART_cdcDataOutEp[USBUART_COM_PORT1] != epNumber)
+    {
+        printf("EpCopy_ReadOutEP() on endpoint %u\n", epNumber);
+        exit(1);
+    }
+    return USBUART_GetData(data, length);
+}
+
+/* [] END OF FILE */
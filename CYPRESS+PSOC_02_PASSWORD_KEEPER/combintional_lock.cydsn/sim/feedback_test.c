@@ -0,0 +1,398 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host test of the lock's feedback. lock.c runs exactly as the firmware
+ * builds it, with cdc_rx.c, cred.c, the generated cred_table.c, evq.c and
+ * the LCD modules, against models of the CDC endpoints (one OUT packet at
+ * a time, like the SIE), the LEDs and an HD44780 display. Time is
+ * simulated: Lock_Poll() runs SIM_POLLS_PER_MS times per millisecond.
+ *
+ *  1. A stream of '#'-terminated codes, mostly wrong, is sent as fast as
+ *     the endpoint takes it, so most of it arrives while a rejection is on
+ *     screen. Every byte must come back in order, every code must get its
+ *     verdict, and no packet may wait in the endpoint longer than a poll.
+ *  2. A wrong code, then silence: the three rejection screens must appear
+ *     LOCK_FEEDBACK_MS apart with LED 1 on and LED 2 off.
+ *  3. A wrong code followed by a right one before the rejection is over:
+ *     the acceptance replaces it and the retry screen never shows.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn feedback_test.c ep_copy_host.c \
+ *       ../combintional_lock.cydsn/lock.c ../combintional_lock.cydsn/evq.c \
+ *       ../combintional_lock.cydsn/cdc_rx.c ../combintional_lock.cydsn/cdc_tx.c \
+ *       ../combintional_lock.cydsn/cred.c ../combintional_lock.cydsn/cred_table.c \
+ *       ../combintional_lock.cydsn/pw_parse.c ../combintional_lock.cydsn/lcd_fb.c \
+ *       ../combintional_lock.cydsn/lcd_screen.c \
+ *       -o feedback_test
+ *   ./feedback_test [kilobytes] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "lcd_async.h"
+#include "cdc_tx.h"
+#include "lcd_fb.h"
+#include "lock.h"
+
+#define SIM_PACKET          (64u)
+#define SIM_POLLS_PER_MS    (4u)
+#define SIM_MAX_CODE        (8u)
+#define SIM_DDRAM           (0x80u)
+#define SIM_ROW_1           (0x40u)     // DDRAM address of the second row
+
+static const char *const simCodes[] = { "1234", "9021", "55501" };  // sim/credentials.csv
+#define SIM_CODES           (sizeof(simCodes) / sizeof(simCodes[0]))
+
+// the OUT endpoint and the host's stream
+static uint8 simEp[SIM_PACKET];
+static uint16 simEpCount = 0u;
+static uint8 simEpFull = 0u;
+static uint32 simEpLoadedPoll = 0u;
+static uint32 simEpWorstPolls = 0u;
+static uint8 *simStream;
+static uint32 simStreamLen = 0u;
+static uint32 simSent = 0u;
+
+// what came back on the IN endpoint
+static uint8 *simEcho;
+static uint32 simEchoLen = 0u;
+static uint32 simEchoCap = 0u;
+static uint32 simZlps = 0u;
+
+static uint8 simLed[2];
+static char8 simDdram[SIM_DDRAM];
+static uint8 simAddr = 0u;
+
+static uint32 simNowMs = 0u;
+static uint32 simPolls = 0u;
+static uint64 simState;
+
+uint8 USBUART_DataIsReady(void)
+{
+    return simEpFull;
+}
+
+uint16 USBUART_GetCount(void)
+{
+    return (0u != simEpFull) ? simEpCount : 0u;
+}
+
+uint16 USBUART_GetData(uint8 *pData, uint16 length)
+{
+    if (length > simEpCount)
+    {
+        length = simEpCount;
+    }
+    (void)memcpy(pData, simEp, length);
+    simEpFull = 0u;
+    if ((simPolls - simEpLoadedPoll) > simEpWorstPolls)
+    {
+        simEpWorstPolls = simPolls - simEpLoadedPoll;
+    }
+    return length;
+}
+
+uint16 USBUART_GetAll(uint8 *pData)
+{
+    return USBUART_GetData(pData, SIM_PACKET);
+}
+
+uint8 USBUART_CDCIsReady(void)
+{
+    // the host reads every IN packet as soon as it is sent
+    return 1u;
+}
+
+void USBUART_PutData(const uint8 *pData, uint16 length)
+{
+    if (0u == length)
+    {
+        simZlps++;
+        return;
+    }
+    if ((simEchoLen + length) <= simEchoCap)
+    {
+        (void)memcpy(&simEcho[simEchoLen], pData, length);
+    }
+    simEchoLen += length;
+}
+
+uint8 USBUART_IsConfigurationChanged(void)
+{
+    return 0u;
+}
+
+uint8 USBUART_GetConfiguration(void)
+{
+    return 1u;
+}
+
+uint8 USBUART_CDC_Init(void)
+{
+    return 1u;
+}
+
+void Pin_1_Write(uint8 value)
+{
+    simLed[0] = value;
+}
+
+void Pin_2_Write(uint8 value)
+{
+    simLed[1] = value;
+}
+
+void LcdAsync_Start(void)
+{
+    (void)memset(simDdram, ' ', sizeof(simDdram));
+    simAddr = 0u;
+}
+
+void LcdAsync_WriteControl(uint8 cByte)
+{
+    if (LCD_CLEAR_DISPLAY == cByte)
+    {
+        (void)memset(simDdram, ' ', sizeof(simDdram));
+        simAddr = 0u;
+    }
+    else if (0u != (cByte & 0x80u))
+    {
+        simAddr = cByte & 0x7Fu;
+    }
+}
+
+void LcdAsync_WriteData(uint8 dByte)
+{
+    simDdram[simAddr & 0x7Fu] = (char8)dByte;
+    simAddr = (simAddr + 1u) & 0x7Fu;
+}
+
+void LcdAsync_Position(uint8 row, uint8 column)
+{
+    simAddr = (uint8)(((0u != row) ? SIM_ROW_1 : 0u) + column);
+}
+
+void LcdAsync_PrintString(char8 const string[])
+{
+    while ('\0' != *string)
+    {
+        LcdAsync_WriteData((uint8)*string++);
+    }
+}
+
+uint8 LcdAsync_IsIdle(void)
+{
+    return 1u;
+}
+
+void LcdAsync_WaitIdle(void)
+{
+}
+
+void LcdAsync_SetCallback(lcd_async_callback_t callback)
+{
+    (void)callback;
+}
+
+static uint32 Sim_Rand(void)
+{
+    // xorshift64*, independent of the firmware
+    simState ^= simState >> 12u;
+    simState ^= simState << 25u;
+    simState ^= simState >> 27u;
+    return (uint32)((simState * 2685821657736338717ull) >> 32u);
+}
+
+// 1 if the display row starts with text
+static uint8 Sim_Shows(uint8 row, const char *text)
+{
+    return (0 == memcmp(&simDdram[(0u != row) ? SIM_ROW_1 : 0u], text, strlen(text))) ? 1u : 0u;
+}
+
+// Loads the next packet of random length if the endpoint is free.
+static void Sim_HostSend(void)
+{
+    uint16 length;
+
+    if ((0u != simEpFull) || (simSent >= simStreamLen))
+    {
+        return;
+    }
+
+    length = (uint16)(1u + (Sim_Rand() % SIM_PACKET));
+    if (length > (simStreamLen - simSent))
+    {
+        length = (uint16)(simStreamLen - simSent);
+    }
+    (void)memcpy(simEp, &simStream[simSent], length);
+    simEpCount = length;
+    simEpFull = 1u;
+    simEpLoadedPoll = simPolls;
+    simSent += length;
+}
+
+// One simulated millisecond of the main loop.
+static void Sim_Ms(void)
+{
+    uint8 i;
+
+    for (i = 0u; i < SIM_POLLS_PER_MS; i++)
+    {
+        Sim_HostSend();
+        Lock_Poll(simNowMs);
+        simPolls++;
+    }
+    simNowMs++;
+}
+
+static void Sim_Send(const char *text)
+{
+    simStreamLen = (uint32)strlen(text);
+    simSent = 0u;
+    (void)memcpy(simStream, text, simStreamLen);
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-52s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 size = 256u << 10u;
+    uint32 accepts = 0u;
+    uint32 rejects = 0u;
+    uint32 length;
+    uint32 code;
+    uint32 start;
+    uint32 i;
+    uint32 changes[3] = { 0u, 0u, 0u };
+    uint8 seen = 0u;
+    uint8 failed = 0u;
+    uint8 retryShown = 0u;
+    lock_stats_t stats;
+
+    simState = 0x9E3779B97F4A7C15ull;
+    if (argc > 1)
+    {
+        size = (uint32)strtoul(argv[1], NULL, 0) << 10u;
+    }
+    if (argc > 2)
+    {
+        simState ^= strtoull(argv[2], NULL, 0);
+    }
+    if (size < 64u)
+    {
+        size = 64u;
+    }
+
+    simStream = (uint8 *)malloc(size + SIM_MAX_CODE + 1u);
+    simEchoCap = size + SIM_MAX_CODE + 1u;
+    simEcho = (uint8 *)malloc(simEchoCap);
+
+    // one code in eight is right, the rest are random digits
+    while (simStreamLen < size)
+    {
+        start = simStreamLen;
+        if (0u == (Sim_Rand() % 8u))
+        {
+            code = Sim_Rand() % SIM_CODES;
+            length = (uint32)strlen(simCodes[code]);
+            (void)memcpy(&simStream[simStreamLen], simCodes[code], length);
+            simStreamLen += length;
+        }
+        else
+        {
+            length = 1u + (Sim_Rand() % SIM_MAX_CODE);
+            for (i = 0u; i < length; i++)
+            {
+                simStream[simStreamLen++] = (uint8)('0' + (Sim_Rand() % 10u));
+            }
+        }
+        // a random code can still be right
+        code = 0u;
+        for (i = 0u; i < SIM_CODES; i++)
+        {
+            if ((strlen(simCodes[i]) == length) && (0 == memcmp(&simStream[start], simCodes[i], length)))
+            {
+                code = 1u;
+            }
+        }
+        accepts += code;
+        rejects += 1u - code;
+        simStream[simStreamLen++] = '#';
+    }
+
+    LcdFb_Init();
+    Lock_Init();
+
+    // 1. streaming through the feedback
+    while ((simSent < simStreamLen) || (0u != simEpFull) || (0u == CdcTx_IsIdle()))
+    {
+        Sim_Ms();
+    }
+    Lock_GetStats(&stats);
+    printf("%u bytes, %u codes (%u right) in %u ms, %u ZLPs\n\n",
+        simStreamLen, accepts + rejects, accepts, simNowMs, simZlps);
+    failed |= Sim_Check((simEchoLen == simStreamLen) && (0 == memcmp(simEcho, simStream, simStreamLen)),
+        "every byte echoed in order");
+    failed |= Sim_Check((stats.accepted == accepts) && (stats.rejected == rejects),
+        "every code got its verdict");
+    failed |= Sim_Check(simEpWorstPolls <= 1u, "no packet waits in the endpoint past a poll");
+
+    // 2. a rejection played out in full
+    Sim_Send("4321#");
+    start = simNowMs;
+    while ((uint32)(simNowMs - start) < ((3u * LOCK_FEEDBACK_MS) + 10u))
+    {
+        Sim_Ms();
+        if ((seen < 3u) && (0u != Sim_Shows(0u,
+            (0u == seen) ? "Invalid Password" : ((1u == seen) ? "Access denied" : "Enter Correct"))))
+        {
+            changes[seen++] = simNowMs - 1u - start;
+        }
+    }
+    printf("\nrejection screens at %u, %u and %u ms\n", changes[0], changes[1], changes[2]);
+    failed |= Sim_Check((3u == seen) && (0u == changes[0]) &&
+        (LOCK_FEEDBACK_MS == changes[1]) && ((2u * LOCK_FEEDBACK_MS) == changes[2]),
+        "rejection screens LOCK_FEEDBACK_MS apart");
+    failed |= Sim_Check((0u != Sim_Shows(1u, "Password")) && (0u == Lock_IsFeedbackBusy()),
+        "retry screen stays");
+    failed |= Sim_Check((1u == simLed[0]) && (0u == simLed[1]), "LED 1 on, LED 2 off");
+
+    // 3. the right code cuts the rejection short
+    Sim_Send("77#9021#");
+    start = simNowMs;
+    while ((uint32)(simNowMs - start) < ((3u * LOCK_FEEDBACK_MS) + 10u))
+    {
+        Sim_Ms();
+        retryShown |= Sim_Shows(0u, "Enter Correct");
+        if (1u == (simNowMs - start))
+        {
+            failed |= Sim_Check((0u != Sim_Shows(0u, "Password Match:")) && (0u != Sim_Shows(1u, "User 2")),
+                "acceptance replaces the rejection");
+        }
+    }
+    failed |= Sim_Check((0u == retryShown) && (0u != Sim_Shows(0u, "Lock is open")) &&
+        (1u == simLed[0]) && (1u == simLed[1]), "lock opens, retry screen never shows");
+
+    free(simStream);
+    free(simEcho);
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef PROJECT_H
+#define PROJECT_H
+
+/*
+ * Host stand-in for Generated_Source/PSoC5/project.h. It declares the
+ * component calls the portable modules make; the test that links them
+ * provides a model of the hardware behind them.
+ */
+
+#include <string.h>     // CyLib.h includes it, so project.h users get NULL
+#include "cytypes.h"
+
+// USBUART CDC data endpoints
+uint8 USBUART_DataIsReady(void);
+uint16 USBUART_GetCount(void);
+uint16 USBUART_GetData(uint8 *pData, uint16 length);
+uint16 USBUART_GetAll(uint8 *pData);
+uint8 USBUART_CDCIsReady(void);
+void USBUART_PutData(const uint8 *pData, uint16 length);
+void USBUART_PutChar(char8 txDataByte);
+
+// Endpoint buffer management as in the generated USBUART.h, build with
+// -DUSBUART_EP_MM=2 for DMA with Automatic Buffer Management
+#ifndef USBUART_EP_MM
+    #define USBUART_EP_MM                   (0u)
+#endif /* USBUART_EP_MM */
+#define USBUART__EP_MANUAL                  (0u)
+#define USBUART__EP_DMAMANUAL               (1u)
+#define USBUART__EP_DMAAUTO                 (2u)
+#define USBUART_EP_MANAGEMENT_MANUAL        (USBUART_EP_MM == USBUART__EP_MANUAL)
+#define USBUART_EP_MANAGEMENT_DMA           (USBUART_EP_MM != USBUART__EP_MANUAL)
+#define USBUART_EP_MANAGEMENT_DMA_MANUAL    (USBUART_EP_MM == USBUART__EP_DMAMANUAL)
+#define USBUART_EP_MANAGEMENT_DMA_AUTO      (USBUART_EP_MM == USBUART__EP_DMAAUTO)
+
+// USBUART endpoint calls the DMA modes need
+#define USBUART_COM_PORT1                   (0u)
+extern volatile uint8 USBUART_cdcDataInEp[2];
+extern volatile uint8 USBUART_cdcDataOutEp[2];
+uint16 USBUART_ReadOutEP(uint8 epNumber, uint8 pData[], uint16 length);
+void USBUART_EnableOutEP(uint8 epNumber);
+
+// USBUART device state
+uint8 USBUART_IsConfigurationChanged(void);
+uint8 USBUART_GetConfiguration(void);
+uint8 USBUART_CDC_Init(void);
+
+// UART_1 with its own interrupts off, as uart_ring.c uses it
+#define UART_1_RX_STS_BREAK                 (0x02u)
+#define UART_1_RX_STS_PAR_ERROR             (0x04u)
+#define UART_1_RX_STS_STOP_ERROR            (0x08u)
+#define UART_1_RX_STS_OVERRUN               (0x10u)
+#define UART_1_RX_STS_FIFO_NOTEMPTY         (0x20u)
+#define UART_1_TX_STS_FIFO_EMPTY            (0x02u)
+#define UART_1_TX_STS_FIFO_FULL             (0x04u)
+#define UART_1_TX_STS_FIFO_NOT_FULL         (0x08u)
+void UART_1_SetRxInterruptMode(uint8 intSrc);
+void UART_1_SetTxInterruptMode(uint8 intSrc);
+uint8 UART_1_ReadRxStatus(void);
+uint8 UART_1_ReadRxData(void);
+uint8 UART_1_ReadTxStatus(void);
+void UART_1_WriteTxData(uint8 txDataByte);
+void isr_UART_RX_StartEx(cyisraddress address);
+
+// CyLib critical sections
+uint8 CyEnterCriticalSection(void);
+void CyExitCriticalSection(uint8 savedIntrStatus);
+
+// LEDs
+void Pin_1_Write(uint8 value);
+void Pin_2_Write(uint8 value);
+
+// Character LCD
+#define LCD_CLEAR_DISPLAY   (0x01u)
+#define LCD_ROW_0_START     (0x80u)
+#define LCD_ROW_1_START     (0xC0u)
+
+#endif /* PROJECT_H */
+/* [] END OF FILE */
@@ -0,0 +1,261 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Fuzz harness for pw_parse.c. Each stream picks a random password, sends
+ * a random mix of attempts (the password, prefixes and extensions of it,
+ * one-byte changes, random bytes of any value, empty attempts) and cuts
+ * the stream into chunks of random length as USB packets would. Every
+ * verdict is checked against a plain reference: collect the attempt, then
+ * compare it whole.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn pw_parse_fuzz.c \
+ *       ../combintional_lock.cydsn/pw_parse.c -o pw_parse_fuzz
+ *   ./pw_parse_fuzz [streams] [seed]
+ *
+ * Add -fsanitize=address,undefined -g to catch any out-of-bounds access.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cytypes.h"
+#include "pw_parse.h"
+
+#define SIM_DEFAULT_STREAMS (2000000u)
+#define SIM_ATTEMPTS        (8u)            // per stream
+#define SIM_MAX_ATTEMPT     (PW_PARSE_MAX_LEN + 16u)
+#define SIM_STREAM_SIZE     (SIM_ATTEMPTS * (SIM_MAX_ATTEMPT + 1u))
+#define SIM_CHUNK           (64u)
+#define SIM_BENCH_BYTES     (256u << 20u)
+
+static uint64 simState;
+
+static uint32 Sim_Rand(void)
+{
+    simState ^= simState >> 12u;
+    simState ^= simState << 25u;
+    simState ^= simState >> 27u;
+    return (uint32)((simState * 2685821657736338717ull) >> 32u);
+}
+
+static uint8 Sim_Byte(void)
+{
+    uint8 value;
+
+    do
+    {
+        value = (uint8)Sim_Rand();
+    } while (PW_PARSE_TERMINATOR == value);
+    return value;
+}
+
+static double Sim_Seconds(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+// Appends one attempt and its terminator, returns the new stream length.
+static uint32 Sim_Attempt(uint8 *stream, uint32 at, const char8 *secret, uint8 length)
+{
+    uint32 size;
+    uint32 i;
+
+    switch (Sim_Rand() % 6u)
+    {
+        case 0u:    // the password
+            (void)memcpy(&stream[at], secret, length);
+            size = length;
+            break;
+
+        case 1u:    // a prefix
+            size = (0u != length) ? (Sim_Rand() % length) : 0u;
+            (void)memcpy(&stream[at], secret, size);
+            break;
+
+        case 2u:    // the password and more
+            (void)memcpy(&stream[at], secret, length);
+            size = length + 1u + (Sim_Rand() % 16u);
+            for (i = length; i < size; i++)
+            {
+                stream[at + i] = Sim_Byte();
+            }
+            break;
+
+        case 3u:    // one byte changed
+            (void)memcpy(&stream[at], secret, length);
+            size = length;
+            if (0u != length)
+            {
+                i = Sim_Rand() % length;
+                do
+                {
+                    stream[at + i] = Sim_Byte();
+                } while (stream[at + i] == (uint8)secret[i]);
+            }
+            break;
+
+        case 4u:    // noise
+            size = Sim_Rand() % (SIM_MAX_ATTEMPT + 1u);
+            for (i = 0u; i < size; i++)
+            {
+                stream[at + i] = Sim_Byte();
+            }
+            break;
+
+        default:    // empty
+            size = 0u;
+            break;
+    }
+
+    stream[at + size] = PW_PARSE_TERMINATOR;
+    return at + size + 1u;
+}
+
+// Reference verdicts: split on the terminator, compare whole attempts.
+static uint32 Sim_Reference(const uint8 *stream, uint32 size, const char8 *secret, uint8 length,
+    uint8 *verdicts)
+{
+    uint32 count = 0u;
+    uint32 start = 0u;
+    uint32 i;
+
+    for (i = 0u; i < size; i++)
+    {
+        if (PW_PARSE_TERMINATOR == stream[i])
+        {
+            verdicts[count++] = (((i - start) == length) && (0 == memcmp(&stream[start], secret, length))) ?
+                PW_PARSE_ACCEPT : PW_PARSE_REJECT;
+            start = i + 1u;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8 stream[SIM_STREAM_SIZE];
+    static uint8 *bench;
+    char8 secret[PW_PARSE_MAX_LEN];
+    uint8 expect[SIM_ATTEMPTS];
+    uint32 streams = SIM_DEFAULT_STREAMS;
+    uint32 failures = 0u;
+    uint32 accepts = 0u;
+    uint32 verdicts = 0u;
+    uint32 expected;
+    uint32 got;
+    uint32 size;
+    uint32 pos;
+    uint32 chunk;
+    uint32 n;
+    uint32 i;
+    uint16 at;
+    uint16 used;
+    uint8 length;
+    uint8 verdict;
+    pw_parse_t parser;
+    double start;
+    double seconds;
+
+    simState = 0x243F6A8885A308D3ull;
+    if (argc > 1)
+    {
+        streams = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        simState ^= strtoull(argv[2], NULL, 0);
+    }
+
+    for (n = 0u; n < streams; n++)
+    {
+        // short passwords most of the time, any length now and then
+        length = (uint8)((0u == (Sim_Rand() % 8u)) ? (Sim_Rand() % (PW_PARSE_MAX_LEN + 1u)) :
+            (Sim_Rand() % 17u));
+        for (i = 0u; i < length; i++)
+        {
+            secret[i] = (char8)Sim_Byte();
+        }
+
+        size = 0u;
+        for (i = 0u; i < SIM_ATTEMPTS; i++)
+        {
+            size = Sim_Attempt(stream, size, secret, length);
+        }
+        expected = Sim_Reference(stream, size, secret, length, expect);
+
+        PwParse_Init(&parser, secret, length);
+        got = 0u;
+        for (pos = 0u; pos < size; pos += chunk)
+        {
+            chunk = 1u + (Sim_Rand() % SIM_CHUNK);
+            if (chunk > (size - pos))
+            {
+                chunk = size - pos;
+            }
+            for (at = 0u; at < chunk; at += used)
+            {
+                verdict = PwParse_Push(&parser, &stream[pos + at], (uint16)(chunk - at), &used);
+                if (PW_PARSE_NONE == verdict)
+                {
+                    continue;
+                }
+                if ((got >= expected) || (verdict != expect[got]))
+                {
+                    failures++;
+                }
+                accepts += (PW_PARSE_ACCEPT == verdict) ? 1u : 0u;
+                got++;
+            }
+        }
+        failures += (got != expected) ? 1u : 0u;
+        verdicts += got;
+    }
+
+    printf("%u streams, %u attempts, %u accepted, %u mismatches with the reference\n",
+        streams, verdicts, accepts, failures);
+
+    // throughput on a long stream of 4-digit guesses in 64-byte packets
+    bench = (uint8 *)malloc(SIM_BENCH_BYTES);
+    (void)memset(bench, PW_PARSE_TERMINATOR, SIM_BENCH_BYTES);
+    for (i = 0u; (i + 5u) <= SIM_BENCH_BYTES; i += 5u)
+    {
+        bench[i] = (uint8)('0' + (Sim_Rand() % 10u));
+        bench[i + 1u] = (uint8)('0' + (Sim_Rand() % 10u));
+        bench[i + 2u] = (uint8)('0' + (Sim_Rand() % 10u));
+        bench[i + 3u] = (uint8)('0' + (Sim_Rand() % 10u));
+        bench[i + 4u] = PW_PARSE_TERMINATOR;
+    }
+    PwParse_Init(&parser, "1234", 4u);
+    got = 0u;
+    start = Sim_Seconds();
+    for (pos = 0u; pos < SIM_BENCH_BYTES; pos += SIM_CHUNK)
+    {
+        for (at = 0u; at < SIM_CHUNK; at += used)
+        {
+            got += (PW_PARSE_NONE != PwParse_Push(&parser, &bench[pos + at], SIM_CHUNK - at, &used)) ? 1u : 0u;
+        }
+    }
+    seconds = Sim_Seconds() - start;
+    printf("parse throughput %.0f MB/s, %.1f M attempts/s\n",
+        ((double)SIM_BENCH_BYTES / (1024.0 * 1024.0)) / seconds, ((double)got * 1e-6) / seconds);
+    free(bench);
+
+    return (0u == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,463 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host run of stream_bench.c on a model of each link's far end, built once
+ * per backend:
+ *
+ *   STREAM_CDC   a full-speed bus where OUT and IN transactions take turns
+ *                and the host echoes every IN packet back in OUT packets
+ *                as soon as it has read it (a real host adds its own
+ *                turnaround on top). cdc_rx.c and cdc_tx.c run in manual
+ *                endpoint mode.
+ *   STREAM_UART  UART_1 at 115200 baud with its tx pin wired to its rx pin,
+ *                4-byte FIFOs, the RX interrupt and the polled TX of
+ *                uart_ring.c.
+ *
+ * The main loop runs every SIM_LOOP_NS and costs no time itself. The test
+ * checks that the pattern comes back intact, prints the loopback KB/s, and
+ * then the round trip of single bytes written the way the lock echoes,
+ * i.e. without Stream_Flush(), and with it.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn stream_bench_test.c \
+ *       ep_copy_host.c ../combintional_lock.cydsn/stream_bench.c \
+ *       ../combintional_lock.cydsn/cdc_rx.c ../combintional_lock.cydsn/cdc_tx.c \
+ *       -o stream_bench_cdc
+ *   gcc -O2 -I. -I../combintional_lock.cydsn -DSTREAM_BENCH_LINK=1 \
+ *       -DUART_RING_ENABLE=1 -DUART_RING_TX_DMA=0 stream_bench_test.c \
+ *       ep_copy_host.c ../combintional_lock.cydsn/stream_bench.c \
+ *       ../combintional_lock.cydsn/cdc_rx.c ../combintional_lock.cydsn/cdc_tx.c \
+ *       ../combintional_lock.cydsn/uart_ring.c -o stream_bench_uart
+ *   ./stream_bench_cdc [milliseconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "stream.h"
+#include "stream_bench.h"
+#include "lcd_screen.h"
+#include "tick.h"
+
+#define SIM_LOOP_NS         (20000u)
+#define SIM_DEFAULT_MS      (2000u)
+#define SIM_PROBES          (100u)
+
+#define SIM_PACKET          (64u)
+#define SIM_ECHO_SIZE       (4096u)
+
+// bus, in ns; one byte is 8 bits at 12 Mbit/s
+#define SIM_BYTE_NS         (667u)
+#define SIM_FRAME_NS        (1000000u)
+#define SIM_SOF_NS          (6u * SIM_BYTE_NS)
+#define SIM_DATA_NS(n)      (((n) + 14u) * SIM_BYTE_NS)    // token, data, handshake, gaps
+#define SIM_NAK_NS          (8u * SIM_BYTE_NS)
+
+// UART, 10 bits at 115200
+#define SIM_CHAR_NS         (86806u)
+#define SIM_FIFO            (4u)
+
+static uint64 simNs = 0u;
+static uint8 simMasked = 0u;
+
+uint32 Tick_GetUs(void)
+{
+    return (uint32)(simNs / 1000u);
+}
+
+uint32 Tick_GetMs(void)
+{
+    return (uint32)(simNs / 1000000u);
+}
+
+uint8 CyEnterCriticalSection(void)
+{
+    uint8 state = simMasked;
+
+    simMasked = 1u;
+    return state;
+}
+
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    simMasked = savedIntrStatus;
+}
+
+// StreamBench_Run() shows its results, it is not run here
+uint16 LcdScreen_Show(const lcd_screen_t *screen, ...)
+{
+    (void)screen;
+    return 0u;
+}
+
+// USB CDC, the endpoints and the echoing host
+
+static uint8 simOut[SIM_PACKET];
+static uint16 simOutCount = 0u;
+static uint8 simOutFull = 0u;
+static uint8 simIn[SIM_PACKET];
+static uint16 simInCount = 0u;
+static uint8 simInFull = 0u;
+
+uint8 USBUART_IsConfigurationChanged(void)
+{
+    static uint8 configured = 0u;
+    uint8 changed = (0u == configured) ? 1u : 0u;
+
+    configured = 1u;
+    return changed;
+}
+
+uint8 USBUART_GetConfiguration(void)
+{
+    return 1u;
+}
+
+uint8 USBUART_CDC_Init(void)
+{
+    return 1u;
+}
+
+uint8 USBUART_DataIsReady(void)
+{
+    return simOutFull;
+}
+
+uint16 USBUART_GetCount(void)
+{
+    return (0u != simOutFull) ? simOutCount : 0u;
+}
+
+uint16 USBUART_GetData(uint8 *pData, uint16 length)
+{
+    if (length > simOutCount)
+    {
+        length = simOutCount;
+    }
+    (void)memcpy(pData, simOut, length);
+    simOutFull = 0u;
+    return length;
+}
+
+uint16 USBUART_ReadOutEP(uint8 epNumber, uint8 pData[], uint16 length)
+{
+    (void)epNumber;
+    (void)pData;
+    return length;
+}
+
+void USBUART_EnableOutEP(uint8 epNumber)
+{
+    (void)epNumber;
+    simOutFull = 0u;
+}
+
+uint8 USBUART_CDCIsReady(void)
+{
+    return (0u == simInFull) ? 1u : 0u;
+}
+
+void USBUART_PutData(const uint8 *pData, uint16 length)
+{
+    if (NULL != pData)
+    {
+        (void)memcpy(simIn, pData, length);
+    }
+    simInCount = length;
+    simInFull = 1u;
+}
+
+#if (STREAM_UART != STREAM_BENCH_LINK)
+
+static uint64 simBusNs = 0u;        // the bus is busy until then
+static uint8 simBusTurn = 0u;       // 0: OUT next, 1: IN next
+static uint8 simEcho[SIM_ECHO_SIZE];  // read by the host, not yet sent back
+static uint32 simEchoHead = 0u;
+static uint32 simEchoTail = 0u;
+
+// Runs the bus until simNs.
+static void Sim_Bus(void)
+{
+    uint64 frame;
+    uint64 cost;
+    uint16 length;
+    uint16 i;
+
+    while (simBusNs <= simNs)
+    {
+        frame = simBusNs - (simBusNs % SIM_FRAME_NS);
+        if (simBusNs == frame)
+        {
+            simBusNs += SIM_SOF_NS;
+            continue;
+        }
+
+        if (0u == simBusTurn)
+        {
+            // OUT, what the host has to echo
+            length = (uint16)(simEchoHead - simEchoTail);
+            if (length > SIM_PACKET)
+            {
+                length = SIM_PACKET;
+            }
+            cost = (0u == length) ? 0u : ((0u != simOutFull) ? SIM_NAK_NS : SIM_DATA_NS(length));
+            if ((0u != cost) && ((simBusNs + cost) <= (frame + SIM_FRAME_NS)) && (0u == simOutFull))
+            {
+                for (i = 0u; i < length; i++)
+                {
+                    simOut[i] = simEcho[(simEchoTail + i) % SIM_ECHO_SIZE];
+                }
+                simEchoTail += length;
+                simOutCount = length;
+                simOutFull = 1u;
+            }
+        }
+        else
+        {
+            // IN, the host keeps a read posted
+            cost = (0u != simInFull) ? SIM_DATA_NS(simInCount) : SIM_NAK_NS;
+            if ((0u != simInFull) && ((simBusNs + cost) <= (frame + SIM_FRAME_NS))
+                && ((simEchoHead - simEchoTail + simInCount) <= SIM_ECHO_SIZE))
+            {
+                for (i = 0u; i < simInCount; i++)
+                {
+                    simEcho[(simEchoHead + i) % SIM_ECHO_SIZE] = simIn[i];
+                }
+                simEchoHead += simInCount;
+                simInFull = 0u;
+            }
+        }
+        simBusTurn ^= 1u;
+
+        if ((simBusNs + cost) > (frame + SIM_FRAME_NS))
+        {
+            // does not fit in this frame
+            simBusNs = frame + SIM_FRAME_NS;
+        }
+        else
+        {
+            simBusNs += (0u != cost) ? cost : SIM_NAK_NS;
+        }
+    }
+}
+
+#endif /* STREAM_UART != STREAM_BENCH_LINK */
+
+// UART_1 with tx wired to rx
+
+static cyisraddress simRxIsr = NULL;
+static uint8 rxFifo[SIM_FIFO];
+static uint8 rxFifoCount = 0u;
+static uint8 rxSticky = 0u;
+static uint8 txFifo[SIM_FIFO];
+static uint8 txFifoCount = 0u;
+
+void isr_UART_RX_StartEx(cyisraddress address)
+{
+    simRxIsr = address;
+}
+
+void UART_1_SetRxInterruptMode(uint8 intSrc)
+{
+    (void)intSrc;
+}
+
+void UART_1_SetTxInterruptMode(uint8 intSrc)
+{
+    (void)intSrc;
+}
+
+uint8 UART_1_ReadRxStatus(void)
+{
+    uint8 status = rxSticky;
+
+    rxSticky = 0u;
+    if (0u != rxFifoCount)
+    {
+        status |= UART_1_RX_STS_FIFO_NOTEMPTY;
+    }
+    return status;
+}
+
+uint8 UART_1_ReadRxData(void)
+{
+    uint8 data = rxFifo[0];
+
+    if (0u != rxFifoCount)
+    {
+        rxFifoCount--;
+        (void)memmove(rxFifo, &rxFifo[1], rxFifoCount);
+    }
+    return data;
+}
+
+uint8 UART_1_ReadTxStatus(void)
+{
+    return (txFifoCount < SIM_FIFO) ? UART_1_TX_STS_FIFO_NOT_FULL : UART_1_TX_STS_FIFO_FULL;
+}
+
+void UART_1_WriteTxData(uint8 txDataByte)
+{
+    if (txFifoCount < SIM_FIFO)
+    {
+        txFifo[txFifoCount] = txDataByte;
+        txFifoCount++;
+    }
+}
+
+#if (STREAM_UART == STREAM_BENCH_LINK)
+
+static uint8 txShifting = 0u;
+static uint8 txByte = 0u;
+static uint64 txShiftEnd = 0u;
+
+// Runs the wire until simNs; the RX interrupt runs as bytes land.
+static void Sim_Wire(void)
+{
+    for (;;)
+    {
+        if ((0u == txShifting) && (0u != txFifoCount))
+        {
+            txByte = txFifo[0];
+            txFifoCount--;
+            (void)memmove(txFifo, &txFifo[1], txFifoCount);
+            txShifting = 1u;
+            txShiftEnd += SIM_CHAR_NS;
+        }
+        if ((0u == txShifting) || (txShiftEnd > simNs))
+        {
+            break;
+        }
+
+        txShifting = 0u;
+        if (rxFifoCount < SIM_FIFO)
+        {
+            rxFifo[rxFifoCount] = txByte;
+            rxFifoCount++;
+        }
+        else
+        {
+            rxSticky |= UART_1_RX_STS_OVERRUN;
+        }
+        if ((0u == simMasked) && (NULL != simRxIsr))
+        {
+            simRxIsr();
+        }
+    }
+    if (0u == txShifting)
+    {
+        // the next byte starts when it is written
+        txShiftEnd = simNs;
+    }
+}
+
+#endif /* STREAM_UART == STREAM_BENCH_LINK */
+
+static void Sim_Advance(uint64 ns)
+{
+    simNs += ns;
+    #if (STREAM_UART == STREAM_BENCH_LINK)
+        Sim_Wire();
+    #else
+        Sim_Bus();
+    #endif /* STREAM_UART == STREAM_BENCH_LINK */
+}
+
+int main(int argc, char *argv[])
+{
+    stream_bench_t bench;
+    uint32 milliseconds = SIM_DEFAULT_MS;
+    uint64 startNs;
+    uint64 totalNs = 0u;
+    uint64 worstNs = 0u;
+    uint64 ns;
+    uint8 probe = 0xA5u;
+    uint8 back;
+    uint32 i;
+
+    if (argc > 1)
+    {
+        milliseconds = (uint32)strtoul(argv[1], NULL, 0);
+    }
+
+    StreamBench_Start(&bench);
+    startNs = simNs;
+    while ((simNs - startNs) < ((uint64)milliseconds * 1000000u))
+    {
+        StreamBench_Poll(&bench, Tick_GetMs());
+        Sim_Advance(SIM_LOOP_NS);
+    }
+    printf("%s loopback for %u ms, %u bytes in flight at most\n",
+           (STREAM_UART == STREAM_BENCH_LINK) ? "UART 115200" : "USB CDC", milliseconds,
+           (uint32)STREAM_BENCH_IN_FLIGHT);
+    printf("  %u sent, %u back, %u wrong, %.1f KB/s\n", bench.sent, bench.received, bench.errors,
+           ((double)bench.received * 1000.0) / ((double)milliseconds * 1024.0));
+
+    // let what is out come back, then single bytes as the lock echoes them
+    for (i = 0u; i < 5000u; i++)
+    {
+        (void)Stream_Service(STREAM_BENCH_LINK, Tick_GetMs());
+        Sim_Advance(SIM_LOOP_NS);
+        Stream_Receive(STREAM_BENCH_LINK);
+        while (0u != Stream_Read(STREAM_BENCH_LINK, &back, 1u))
+        {
+        }
+    }
+    for (i = 0u; i < (2u * SIM_PROBES); i++)
+    {
+        if (SIM_PROBES == i)
+        {
+            printf("  single byte round trip: mean %.0f us, worst %.0f us\n",
+                   (double)totalNs / (SIM_PROBES * 1000.0), (double)worstNs / 1000.0);
+            totalNs = 0u;
+            worstNs = 0u;
+        }
+        (void)Stream_Write(STREAM_BENCH_LINK, &probe, 1u);
+        if (i >= SIM_PROBES)
+        {
+            Stream_Flush(STREAM_BENCH_LINK);
+        }
+        startNs = simNs;
+        for (;;)
+        {
+            (void)Stream_Service(STREAM_BENCH_LINK, Tick_GetMs());
+            Sim_Advance(SIM_LOOP_NS);
+            Stream_Receive(STREAM_BENCH_LINK);
+            if (0u != Stream_Read(STREAM_BENCH_LINK, &back, 1u))
+            {
+                break;
+            }
+        }
+        ns = simNs - startNs;
+        totalNs += ns;
+        if (ns > worstNs)
+        {
+            worstNs = ns;
+        }
+        // start the next one at a different point of the frame
+        Sim_Advance((uint64)SIM_LOOP_NS * (1u + (i % 37u)));
+    }
+    printf("  the same with Stream_Flush(): mean %.0f us, worst %.0f us\n",
+           (double)totalNs / (SIM_PROBES * 1000.0), (double)worstNs / 1000.0);
+
+    if ((0u != bench.errors) || (0u == bench.received))
+    {
+        printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,56 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "token.h"
+
+void Token_Init(token_t *token)
+{
+    token->text[0] = '\0';
+    token->length = 0u;
+    token->overflow = 0u;
+    token->complete = 0u;
+}
+
+uint8 Token_Push(token_t *token, const uint8 *data, uint16 length, uint16 *used)
+{
+    const uint8 *end = (const uint8 *)memchr(data, TOKEN_TERMINATOR, length);
+    uint16 part = (NULL != end) ? (uint16)(end - data) : length;
+
+    // the last token has been handed out, this data starts the next one
+    if (0u != token->complete)
+    {
+        Token_Init(token);
+    }
+
+    if ((0u == token->overflow) && (part <= (TOKEN_MAX_LEN - token->length)))
+    {
+        (void)memcpy(&token->text[token->length], data, part);
+        token->length += part;
+    }
+    else
+    {
+        token->overflow = 1u;
+    }
+
+    if (NULL == end)
+    {
+        *used = part;
+        return TOKEN_NONE;
+    }
+
+    *used = part + 1u;
+    token->complete = 1u;
+    token->text[token->length] = '\0';
+    return (0u != token->overflow) ? TOKEN_OVERFLOW : TOKEN_READY;
+}
+
+/* [] END OF FILE */
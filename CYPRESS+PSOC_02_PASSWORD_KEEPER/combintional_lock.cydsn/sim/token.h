@@ -0,0 +1,55 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef TOKEN_H
+#define TOKEN_H
+
+#include "cytypes.h"
+
+/*
+ * Splits a byte stream into TOKEN_TERMINATOR-terminated tokens, e.g. the
+ * "1234#" of a password attempt. Host only, for cdc_rx_bench.c. Token_Push() takes whatever chunk the
+ * receive path has and stops right after a terminator, so the caller
+ * handles the token and pushes the rest of the chunk. A token longer than
+ * TOKEN_MAX_LEN is not kept; it is reported as an overflow once its
+ * terminator arrives.
+ */
+
+#ifndef TOKEN_TERMINATOR
+    #define TOKEN_TERMINATOR    ('#')
+#endif /* TOKEN_TERMINATOR */
+
+#ifndef TOKEN_MAX_LEN
+    #define TOKEN_MAX_LEN       (32u)
+#endif /* TOKEN_MAX_LEN */
+
+// Token_Push() results
+#define TOKEN_NONE              (0u)    // no terminator in the data yet
+#define TOKEN_READY             (1u)    // text holds the token
+#define TOKEN_OVERFLOW          (2u)    // the token was too long and dropped
+
+typedef struct
+{
+    char8 text[TOKEN_MAX_LEN + 1u];     // without the terminator, NUL-terminated
+    uint16 length;
+    uint8 overflow;
+    uint8 complete;                     // handed out, the next push starts over
+} token_t;
+
+void Token_Init(token_t *token);
+
+// Consumes data up to and including the next terminator and sets *used to
+// the bytes taken. After TOKEN_READY or TOKEN_OVERFLOW the next call starts
+// a new token.
+uint8 Token_Push(token_t *token, const uint8 *data, uint16 length, uint16 *used);
+
+#endif /* TOKEN_H */
+/* [] END OF FILE */
@@ -0,0 +1,385 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host test of uart_ring.c against a simulated UART_1 at 115200 baud, in
+ * 1 us steps. The RX and TX FIFOs are 4 bytes deep as in the component;
+ * the RX interrupt runs whenever the FIFO holds data or an error bit is
+ * set, unless interrupts are off. The main loop runs every SIM_LOOP_US.
+ *
+ *  - bursts of random bytes with idle gaps between them, some with
+ *    framing, parity or break errors: every byte arrives once and in
+ *    order, each error is counted and each burst ends in one idle line
+ *  - interrupts held off for longer than the FIFO lasts: the overruns and
+ *    the bytes they lose match the model
+ *  - nothing read for a while: the ring fills and the rest is counted as
+ *    dropped
+ *  - sending a long stream with the FIFO topped up from UartRing_Service():
+ *    it arrives in order, and how busy the line stays depends on how often
+ *    the main loop runs
+ *
+ * The DMA TX path splits addresses into 16-bit halves for the PSoC bus, so
+ * it only runs on the board.
+ *
+ *   gcc -O2 -I. -I../combintional_lock.cydsn -DUART_RING_ENABLE=1 \
+ *       -DUART_RING_TX_DMA=0 uart_ring_test.c \
+ *       ../combintional_lock.cydsn/uart_ring.c -o uart_ring_test
+ *   ./uart_ring_test [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "uart_ring.h"
+#include "tick.h"
+
+#define SIM_FIFO            (4u)
+#define SIM_CHAR_US         (87u)       // 10 bits at 115200
+#define SIM_LOOP_US         (50u)
+#define SIM_BURSTS          (200u)
+#define SIM_STREAM          (65536u)
+
+static uint64 simState = 1u;
+static uint32 simNow = 0u;
+static uint8 simMasked = 0u;
+static cyisraddress simRxIsr = NULL;
+
+// RX side of the UART
+static uint8 rxFifo[SIM_FIFO];
+static uint8 rxFifoCount = 0u;
+static uint8 rxSticky = 0u;
+static uint32 rxLost = 0u;          // bytes that found the FIFO full
+
+// TX side of the UART
+static uint8 txFifo[SIM_FIFO];
+static uint8 txFifoCount = 0u;
+static uint32 txShiftEnd = 0u;      // when the byte on the wire is done
+static uint8 txShifting = 0u;
+static uint32 txBusyUs = 0u;
+
+// what the far end has received
+static uint8 *simLine;
+static uint32 simLineLen = 0u;
+
+static uint32 Sim_Rand(void)
+{
+    // xorshift64*, independent of the firmware
+    simState ^= simState >> 12u;
+    simState ^= simState << 25u;
+    simState ^= simState >> 27u;
+    return (uint32)((simState * 2685821657736338717ull) >> 32u);
+}
+
+uint32 Tick_GetUs(void)
+{
+    return simNow;
+}
+
+uint8 CyEnterCriticalSection(void)
+{
+    uint8 state = simMasked;
+
+    simMasked = 1u;
+    return state;
+}
+
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    simMasked = savedIntrStatus;
+}
+
+void isr_UART_RX_StartEx(cyisraddress address)
+{
+    simRxIsr = address;
+}
+
+void UART_1_SetRxInterruptMode(uint8 intSrc)
+{
+    (void)intSrc;
+}
+
+void UART_1_SetTxInterruptMode(uint8 intSrc)
+{
+    (void)intSrc;
+}
+
+uint8 UART_1_ReadRxStatus(void)
+{
+    uint8 status = rxSticky;
+
+    rxSticky = 0u;
+    if (0u != rxFifoCount)
+    {
+        status |= UART_1_RX_STS_FIFO_NOTEMPTY;
+    }
+    return status;
+}
+
+uint8 UART_1_ReadRxData(void)
+{
+    uint8 data = rxFifo[0];
+
+    if (0u != rxFifoCount)
+    {
+        rxFifoCount--;
+        (void)memmove(rxFifo, &rxFifo[1], rxFifoCount);
+    }
+    return data;
+}
+
+uint8 UART_1_ReadTxStatus(void)
+{
+    return (txFifoCount < SIM_FIFO) ? UART_1_TX_STS_FIFO_NOT_FULL : UART_1_TX_STS_FIFO_FULL;
+}
+
+void UART_1_WriteTxData(uint8 txDataByte)
+{
+    if (txFifoCount < SIM_FIFO)
+    {
+        txFifo[txFifoCount] = txDataByte;
+        txFifoCount++;
+    }
+}
+
+// A byte finishes arriving on RX, with the status bits it raises.
+static void Sim_RxByte(uint8 data, uint8 errors)
+{
+    rxSticky |= errors;
+    if (rxFifoCount < SIM_FIFO)
+    {
+        rxFifo[rxFifoCount] = data;
+        rxFifoCount++;
+    }
+    else
+    {
+        rxSticky |= UART_1_RX_STS_OVERRUN;
+        rxLost++;
+    }
+}
+
+// One microsecond of the UART and the interrupt controller.
+static void Sim_Step(void)
+{
+    simNow++;
+
+    if ((0u != txShifting) && (simNow >= txShiftEnd))
+    {
+        txShifting = 0u;
+    }
+    if ((0u == txShifting) && (0u != txFifoCount))
+    {
+        simLine[simLineLen] = txFifo[0];
+        simLineLen++;
+        txFifoCount--;
+        (void)memmove(txFifo, &txFifo[1], txFifoCount);
+        txShifting = 1u;
+        txShiftEnd = simNow + SIM_CHAR_US;
+    }
+    if (0u != txShifting)
+    {
+        txBusyUs++;
+    }
+
+    if ((0u == simMasked) && ((0u != rxFifoCount) || (0u != rxSticky)))
+    {
+        simRxIsr();
+    }
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-56s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+static void Sim_Start(void)
+{
+    rxFifoCount = 0u;
+    rxSticky = 0u;
+    rxLost = 0u;
+    txFifoCount = 0u;
+    txShifting = 0u;
+    txBusyUs = 0u;
+    simLineLen = 0u;
+    simMasked = 0u;
+    UartRing_Start();
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8 sent[SIM_STREAM];
+    static uint8 got[SIM_STREAM];
+    static const uint32 loopUs[3] = { 50u, 300u, 1000u };
+    uart_ring_stats_t stats;
+    uint32 sentLen = 0u;
+    uint32 gotLen = 0u;
+    uint32 idles = 0u;
+    uint32 errors[3] = { 0u, 0u, 0u };
+    uint32 maskedRuns = 0u;
+    uint32 burst;
+    uint32 length;
+    uint32 i;
+    uint32 j;
+    uint32 until;
+    uint32 writeAt;
+    uint8 flags;
+    uint8 failed = 0u;
+
+    if (argc > 1)
+    {
+        simState = strtoull(argv[1], NULL, 0) | 1u;
+    }
+
+    simLine = malloc(SIM_STREAM);
+    if (NULL == simLine)
+    {
+        return 1;
+    }
+
+    printf("UART at 115200, idle line after %u us, main loop every %u us\n\n",
+           (uint32)UART_RING_IDLE_US, SIM_LOOP_US);
+
+    // bursts with errors, read as they come
+    Sim_Start();
+    for (burst = 0u; burst < SIM_BURSTS; burst++)
+    {
+        length = 1u + (Sim_Rand() % 200u);
+        for (i = 0u; (i < length) && (sentLen < SIM_STREAM); i++)
+        {
+            flags = 0u;
+            switch (Sim_Rand() % 64u)
+            {
+                case 0u: flags = UART_1_RX_STS_STOP_ERROR; errors[0]++; break;
+                case 1u: flags = UART_1_RX_STS_PAR_ERROR; errors[1]++; break;
+                case 2u: flags = UART_1_RX_STS_BREAK; errors[2]++; break;
+                default: break;
+            }
+            sent[sentLen] = (uint8)Sim_Rand();
+            for (j = 0u; j < SIM_CHAR_US; j++)
+            {
+                Sim_Step();
+                if (0u == (simNow % SIM_LOOP_US))
+                {
+                    gotLen += UartRing_Read(&got[gotLen], (uint16)(1u + (Sim_Rand() % 64u)));
+                    idles += UartRing_Service(simNow);
+                }
+            }
+            Sim_RxByte(sent[sentLen], flags);
+            sentLen++;
+        }
+        // a gap of 0.5 to 3 ms
+        until = simNow + 500u + (Sim_Rand() % 2500u);
+        while (simNow < until)
+        {
+            Sim_Step();
+            if (0u == (simNow % SIM_LOOP_US))
+            {
+                gotLen += UartRing_Read(&got[gotLen], (uint16)(1u + (Sim_Rand() % 64u)));
+                idles += UartRing_Service(simNow);
+            }
+        }
+    }
+    UartRing_GetStats(&stats);
+    printf("%u bytes in %u bursts, high water %u\n", sentLen, SIM_BURSTS, (uint32)stats.rxHighWater);
+    failed |= Sim_Check((gotLen == sentLen) && (0 == memcmp(got, sent, sentLen)), "every byte arrives once and in order");
+    failed |= Sim_Check((stats.framing == errors[0]) && (stats.parity == errors[1]) && (stats.breaks == errors[2]),
+                        "framing, parity and break errors counted");
+    failed |= Sim_Check((idles == SIM_BURSTS) && (stats.frames == SIM_BURSTS), "one idle line per burst");
+    failed |= Sim_Check((0u == stats.overruns) && (0u == stats.dropped), "nothing lost");
+
+    // interrupts held off for 600 us, about 7 characters, now and then
+    Sim_Start();
+    sentLen = 0u;
+    gotLen = 0u;
+    for (i = 0u; i < 4096u; i++)
+    {
+        for (j = 0u; j < SIM_CHAR_US; j++)
+        {
+            if (0u == (simNow % 5000u))
+            {
+                simMasked = 1u;
+                maskedRuns++;
+            }
+            else if (500u == (simNow % 5000u))
+            {
+                simMasked = 0u;
+            }
+            Sim_Step();
+            if ((0u == simMasked) && (0u == (simNow % SIM_LOOP_US)))
+            {
+                gotLen += UartRing_Read(&got[gotLen], 64u);
+            }
+        }
+        Sim_RxByte((uint8)i, 0u);
+    }
+    for (j = 0u; j < 1000u; j++)
+    {
+        simMasked = 0u;
+        Sim_Step();
+    }
+    gotLen += UartRing_Read(&got[gotLen], UART_RING_RX_SIZE);
+    UartRing_GetStats(&stats);
+    printf("\n%u interrupt-off spells, %u bytes lost in the FIFO\n", maskedRuns, rxLost);
+    failed |= Sim_Check((0u != rxLost) && (stats.overruns == maskedRuns), "one overrun counted per spell");
+    failed |= Sim_Check((gotLen + rxLost) == 4096u, "the rest arrives");
+
+    // nothing read
+    Sim_Start();
+    for (i = 0u; i < (UART_RING_RX_SIZE + 100u); i++)
+    {
+        for (j = 0u; j < SIM_CHAR_US; j++)
+        {
+            Sim_Step();
+        }
+        Sim_RxByte((uint8)i, 0u);
+    }
+    Sim_Step();
+    UartRing_GetStats(&stats);
+    printf("\n");
+    failed |= Sim_Check((UartRing_Count() == UART_RING_RX_SIZE) && (stats.dropped == 100u)
+                        && (stats.rxHighWater == UART_RING_RX_SIZE), "a full ring drops and counts the rest");
+
+    // sending, with the FIFO topped up from the main loop
+    printf("\n%u bytes sent, FIFO topped up by UartRing_Service()\n", SIM_STREAM);
+    for (i = 0u; i < SIM_STREAM; i++)
+    {
+        sent[i] = (uint8)Sim_Rand();
+    }
+    for (i = 0u; i < 3u; i++)
+    {
+        Sim_Start();
+        writeAt = 0u;
+        until = simNow;
+        while ((simLineLen < SIM_STREAM) && ((simNow - until) < (SIM_STREAM * SIM_CHAR_US * 4u)))
+        {
+            Sim_Step();
+            if (0u == (simNow % loopUs[i]))
+            {
+                writeAt += UartRing_Write(&sent[writeAt], (uint16)(SIM_STREAM - writeAt > 300u ? 300u : SIM_STREAM - writeAt));
+                (void)UartRing_Service(simNow);
+            }
+        }
+        UartRing_GetStats(&stats);
+        printf("  loop every %4u us: line busy %5.1f%%, tx high water %u\n", loopUs[i],
+               100.0 * (double)txBusyUs / (double)(simNow - until), (uint32)stats.txHighWater);
+        failed |= Sim_Check((simLineLen == SIM_STREAM) && (0 == memcmp(simLine, sent, SIM_STREAM))
+                            && (stats.txBytes == SIM_STREAM) && (0u != UartRing_TxDone()), "  arrives in order");
+    }
+
+    free(simLine);
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
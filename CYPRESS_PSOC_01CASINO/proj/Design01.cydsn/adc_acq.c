@@ -0,0 +1,183 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "adc_acq.h"
+#include "adc_stream.h"
+
+const adc_acq_profile_t AdcAcq_stream =
+{
+    ADC_DEFAULT_RESOLUTION, ADC_ACQ_REF_DEFAULT, 1u, 0u
+};
+
+const adc_acq_profile_t AdcAcq_knob =
+{
+    12u, ADC_ACQ_REF_DEFAULT, 64u, ADC_CLOCK_FREQUENCY / 2u
+};
+
+// Register values the SAR holds now, so only differences are written
+static uint8 acqResolution;
+static uint8 acqCsr3;
+static uint8 acqCsr6;
+static uint16 acqDivider;
+static uint16 acqDefaultDivider;
+static uint8 acqDefaultCsr3;
+static uint8 acqDefaultCsr6;
+
+static uint16 AdcAcq_Divider(uint32 clockHz)
+{
+    uint32 sourceHz = ADC_CLOCK_FREQUENCY * ((uint32)acqDefaultDivider + 1u);
+    uint32 divider;
+
+    if (0u == clockHz)
+    {
+        return acqDefaultDivider;
+    }
+
+    // nearest divider that does not go faster than the component allows
+    divider = (sourceHz + (clockHz / 2u)) / clockHz;
+    if (divider <= acqDefaultDivider)
+    {
+        divider = (uint32)acqDefaultDivider + 1u;
+    }
+    return (uint16)(divider - 1u);
+}
+
+// Switches the SAR to the profile with a single stop/start of conversions.
+static void AdcAcq_Apply(const adc_acq_profile_t *profile)
+{
+    uint16 divider = AdcAcq_Divider(profile->clockHz);
+    uint8 csr3 = acqDefaultCsr3;
+    uint8 csr6 = acqDefaultCsr6;
+
+    switch (profile->reference)
+    {
+        case ADC_ACQ_REF_INTERNAL:
+            csr3 |= ADC_SAR_EN_BUF_VREF_EN;
+            csr6 = ADC_INT_VREF;
+            break;
+
+        case ADC_ACQ_REF_VDDA:
+            csr3 &= (uint8)~ADC_SAR_EN_BUF_VREF_EN;
+            csr6 = ADC_VDDA_VREF;
+            break;
+
+        default:
+            break;
+    }
+
+    if ((profile->resolution == acqResolution) && (csr3 == acqCsr3) &&
+        (csr6 == acqCsr6) && (divider == acqDivider))
+    {
+        return;
+    }
+
+    ADC_StopConvert();
+    if (profile->resolution != acqResolution)
+    {
+        ADC_SetResolution(profile->resolution);
+        acqResolution = profile->resolution;
+    }
+    if (csr3 != acqCsr3)
+    {
+        ADC_SAR_CSR3_REG = csr3;
+        acqCsr3 = csr3;
+    }
+    if (csr6 != acqCsr6)
+    {
+        ADC_SAR_CSR6_REG = csr6;
+        acqCsr6 = csr6;
+    }
+    if (divider != acqDivider)
+    {
+        ADC_theACLK_SetDividerRegister(divider, 1u);
+        acqDivider = divider;
+    }
+    ADC_StartConvert();
+}
+
+void AdcAcq_Init(void)
+{
+    acqResolution = ADC_DEFAULT_RESOLUTION;
+    acqDefaultCsr3 = ADC_SAR_CSR3_REG;
+    acqDefaultCsr6 = ADC_SAR_CSR6_REG;
+    acqDefaultDivider = ADC_theACLK_GetDividerRegister();
+    acqCsr3 = acqDefaultCsr3;
+    acqCsr6 = acqDefaultCsr6;
+    acqDivider = acqDefaultDivider;
+}
+
+void AdcAcq_Burst(const adc_acq_profile_t *profile, adc_acq_stats_t *stats)
+{
+    uint16 samples = profile->samples;
+    uint32 sum = 0u;
+    uint64 sumSquares = 0u;
+    uint16 min = 0xFFFFu;
+    uint16 max = 0u;
+    uint16 value;
+    uint16 i;
+
+    if (0u == samples)
+    {
+        samples = 1u;
+    }
+    else if (samples > ADC_ACQ_MAX_SAMPLES)
+    {
+        samples = ADC_ACQ_MAX_SAMPLES;
+    }
+
+    AdcStream_Pause();
+    AdcAcq_Apply(profile);
+
+    // the first result may still come from the old setup
+    (void)CY_GET_REG8(ADC_SAR_CSR1_PTR);
+    while (0u == (CY_GET_REG8(ADC_SAR_CSR1_PTR) & ADC_SAR_EOF_1))
+    {
+    }
+    (void)CY_GET_REG16(ADC_SAR_WRK_PTR);
+
+    for (i = 0u; i < samples; i++)
+    {
+        while (0u == (CY_GET_REG8(ADC_SAR_CSR1_PTR) & ADC_SAR_EOF_1))
+        {
+        }
+        value = CY_GET_REG16(ADC_SAR_WRK_PTR);
+
+        sum += value;
+        sumSquares += (uint32)value * value;
+        if (value < min)
+        {
+            min = value;
+        }
+        if (value > max)
+        {
+            max = value;
+        }
+    }
+
+    AdcAcq_Apply(&AdcAcq_stream);
+    AdcStream_Resume();
+
+    // n^2 * variance = n * sum(x^2) - sum(x)^2, exact in 64 bits
+    stats->count = samples;
+    stats->min = min;
+    stats->max = max;
+    stats->meanQ8 = (uint32)((((uint64)sum << 8u) + (samples / 2u)) / samples);
+    stats->varianceQ8 = (uint32)(((((uint64)samples * sumSquares) - ((uint64)sum * sum)) << 8u) /
+                                 ((uint32)samples * samples));
+}
+
+uint16 AdcAcq_Mean(const adc_acq_stats_t *stats)
+{
+    return (uint16)((stats->meanQ8 + 0x80u) >> 8u);
+}
+
+/* [] END OF FILE */
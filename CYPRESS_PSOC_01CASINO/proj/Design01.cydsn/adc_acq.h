@@ -0,0 +1,70 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef ADC_ACQ_H
+#define ADC_ACQ_H
+
+#include "cytypes.h"
+
+/*
+ * Per-request ADC acquisition profiles. A profile names a resolution, a
+ * sample count, a SAR clock and a reference; AdcAcq_Burst() switches the
+ * SAR to it with one stop/start of the converter (registers that already
+ * hold the right value are not touched), takes the samples back to back
+ * and folds them into statistics as they arrive, so no sample buffer is
+ * needed. The continuous stream in adc_stream.c is paused for the burst
+ * and resumes in AdcAcq_stream afterwards, at the same position: the
+ * burst's samples never enter the ring and AdcStream_SampleCount() does
+ * not restart.
+ */
+
+// adc_acq_profile_t.reference
+#define ADC_ACQ_REF_DEFAULT     (0u)    // as set in the ADC component
+#define ADC_ACQ_REF_INTERNAL    (1u)    // 1.024 V bandgap through the buffer
+#define ADC_ACQ_REF_VDDA        (2u)    // Vdda, buffer off
+
+#define ADC_ACQ_MAX_SAMPLES     (4096u)
+
+typedef struct
+{
+    uint8 resolution;           // 8, 10 or 12 bits
+    uint8 reference;            // ADC_ACQ_REF_*
+    uint16 samples;             // 1..ADC_ACQ_MAX_SAMPLES, clamped to that
+    uint32 clockHz;             // SAR clock, 0 keeps the component's
+} adc_acq_profile_t;
+
+typedef struct
+{
+    uint16 count;
+    uint16 min;
+    uint16 max;
+    uint32 meanQ8;              // counts * 256
+    uint32 varianceQ8;          // counts^2 * 256
+} adc_acq_stats_t;
+
+// What adc_stream.c runs on: the component's 8-bit setup, fastest clock.
+extern const adc_acq_profile_t AdcAcq_stream;
+
+// Player knob: 12-bit, 64 samples averaged at half clock for settling.
+extern const adc_acq_profile_t AdcAcq_knob;
+
+// Call after ADC_Start(), before AdcStream_Start().
+void AdcAcq_Init(void);
+
+// Runs a burst with the given profile and returns its statistics. Blocks
+// for samples conversions; the stream is paused meanwhile.
+void AdcAcq_Burst(const adc_acq_profile_t *profile, adc_acq_stats_t *stats);
+
+// Mean rounded to whole counts of the profile's resolution.
+uint16 AdcAcq_Mean(const adc_acq_stats_t *stats);
+
+#endif /* ADC_ACQ_H */
+/* [] END OF FILE */
@@ -0,0 +1,51 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "adc_scale.h"
+
+#if (ADC_SCALE_PERCENT_LUT)
+
+#define AS_PCT(c)       (uint8)(((c) * 100u) / ADC_SCALE_MAX_COUNT)
+#define AS_PCT_4(c)     AS_PCT(c), AS_PCT((c) + 1u), AS_PCT((c) + 2u), AS_PCT((c) + 3u)
+#define AS_PCT_16(c)    AS_PCT_4(c), AS_PCT_4((c) + 4u), AS_PCT_4((c) + 8u), AS_PCT_4((c) + 12u)
+#define AS_PCT_64(c)    AS_PCT_16(c), AS_PCT_16((c) + 16u), \
+                        AS_PCT_16((c) + 32u), AS_PCT_16((c) + 48u)
+
+static const uint8 CYCODE percentTable[ADC_SCALE_MAX_COUNT + 1u] =
+{
+    AS_PCT_64(0u), AS_PCT_64(64u), AS_PCT_64(128u), AS_PCT_64(192u)
+};
+
+#endif /* ADC_SCALE_PERCENT_LUT */
+
+uint8 AdcScale_ToPercent(uint16 counts)
+{
+    if (counts > ADC_SCALE_MAX_COUNT)
+    {
+        counts = ADC_SCALE_MAX_COUNT;
+    }
+
+    #if (ADC_SCALE_PERCENT_LUT)
+        return percentTable[counts];
+    #else
+        // one MUL and one LSR, the product fits 32 bits up to 12-bit counts
+        return (uint8)(((uint32)counts * ADC_SCALE_MUL(100u)) >> ADC_SCALE_SHIFT);
+    #endif /* ADC_SCALE_PERCENT_LUT */
+}
+
+uint16 AdcScale_ToMilliVolts(uint16 counts)
+{
+    // the component's gain is full scale over 2^resolution, a plain shift
+    return (uint16)((((uint32)counts * ADC_SCALE_FULL_MV) + (1u << (ADC_SCALE_RESOLUTION - 1u)))
+                    >> ADC_SCALE_RESOLUTION);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,66 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef ADC_SCALE_H
+#define ADC_SCALE_H
+
+#include "cytypes.h"
+
+/*
+ * Integer conversions of ADC counts. The Cortex-M3 has no FPU, so every
+ * division by a constant becomes a multiply by a precomputed reciprocal and
+ * a shift. The constants follow the ADC's configured resolution and range;
+ * a host build defines ADC_SCALE_RESOLUTION and ADC_SCALE_FULL_MV itself.
+ *
+ * Both single-ended ranges span twice the reference, as ADC_CalcGain()
+ * assumes: Vssa to 2 x Vref, and Vssa to Vdda, where the reference is
+ * Vdda / 2. The Vdac range depends on a VDAC the ADC does not know about
+ * and the differential ranges give signed counts, so those do not build.
+ * Counts taken by an adc_acq profile with another reference are out of
+ * this scale.
+ */
+#ifndef ADC_SCALE_RESOLUTION
+    #include "ADC.h"
+    #if ((ADC_DEFAULT_RANGE != ADC__VSS_TO_VREF) && (ADC_DEFAULT_RANGE != ADC__VSSA_TO_VDDA))
+        #error "adc_scale.h needs the ADC in the Vssa to 2 x Vref or the Vssa to Vdda range"
+    #endif
+    #define ADC_SCALE_RESOLUTION    ADC_DEFAULT_RESOLUTION
+    #define ADC_SCALE_FULL_MV       (2u * ADC_DEFAULT_REF_VOLTAGE_MV)
+#endif /* ADC_SCALE_RESOLUTION */
+
+// Percentages come from a 256-byte flash table instead (8-bit mode only).
+#ifndef ADC_SCALE_PERCENT_LUT
+    #define ADC_SCALE_PERCENT_LUT   (0u)
+#endif /* ADC_SCALE_PERCENT_LUT */
+
+#define ADC_SCALE_MAX_COUNT     ((1u << ADC_SCALE_RESOLUTION) - 1u)
+
+/*
+ * (x * ADC_SCALE_MUL(n)) >> ADC_SCALE_SHIFT is exactly
+ * floor(x * n / ADC_SCALE_MAX_COUNT) for every count x: with this shift the
+ * rounded-up reciprocal is off by less than one step over the whole range.
+ */
+#define ADC_SCALE_SHIFT         ((2u * ADC_SCALE_RESOLUTION) + 1u)
+#define ADC_SCALE_MUL(n)        ((uint32)((((uint64)(n) << ADC_SCALE_SHIFT) + \
+                                    ADC_SCALE_MAX_COUNT - 1u) / ADC_SCALE_MAX_COUNT))
+
+#if (ADC_SCALE_PERCENT_LUT) && (ADC_SCALE_RESOLUTION != 8u)
+    #error "ADC_SCALE_PERCENT_LUT needs an 8-bit ADC"
+#endif
+
+// Knob position, 0 at no counts and 100 only at full scale (truncated).
+uint8 AdcScale_ToPercent(uint16 counts);
+
+// ADC_CountsTo_mVolts() without the ADC_SetOffset()/ADC_SetGain() calibration.
+uint16 AdcScale_ToMilliVolts(uint16 counts);
+
+#endif /* ADC_SCALE_H */
+/* [] END OF FILE */
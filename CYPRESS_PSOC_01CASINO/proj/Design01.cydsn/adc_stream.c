@@ -0,0 +1,228 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "adc_stream.h"
+#include "power.h"
+
+static uint16 ring[ADC_STREAM_SIZE];
+static volatile uint32 written = 0u;
+static adc_stream_callback_t blockCallback = NULL;
+
+#if (ADC_STREAM_USE_DMA)
+
+#define DMA_BYTES_PER_BURST     (2u)
+#define DMA_REQUEST_PER_BURST   (1u)
+#define DMA_SRC_BASE            (CYDEV_PERIPH_BASE)
+#define DMA_DST_BASE            (CYDEV_SRAM_BASE)
+
+static uint8 dmaChannel = CY_DMA_INVALID_CHANNEL;
+static uint8 dmaTd[2] = { CY_DMA_INVALID_TD, CY_DMA_INVALID_TD };
+
+// One interrupt per finished half, the TDs keep looping on their own
+static CY_ISR(AdcStream_DmaIsr)
+{
+    uint32 count = written + ADC_STREAM_BLOCK;
+
+    written = count;
+    if (NULL != blockCallback)
+    {
+        blockCallback(&ring[(count - ADC_STREAM_BLOCK) & ADC_STREAM_MASK], ADC_STREAM_BLOCK);
+    }
+}
+
+#else
+
+void ADC_ISR_InterruptCallback(void)
+{
+    uint32 count = written;
+
+    ring[count & ADC_STREAM_MASK] = CY_GET_REG16(ADC_SAR_WRK_PTR);
+    count++;
+    written = count;
+
+    if ((NULL != blockCallback) && (0u == (count & (ADC_STREAM_BLOCK - 1u))))
+    {
+        blockCallback(&ring[(count - ADC_STREAM_BLOCK) & ADC_STREAM_MASK], ADC_STREAM_BLOCK);
+    }
+}
+
+#endif /* ADC_STREAM_USE_DMA */
+
+void AdcStream_Start(void)
+{
+    written = 0u;
+
+    // the stream runs continuously, so the SAR must keep its clock when idle
+    Power_Require(POWER_NEED_ADC);
+
+#if (ADC_STREAM_USE_DMA)
+    if (CY_DMA_INVALID_CHANNEL == dmaChannel)
+    {
+        dmaChannel = DMA_ADC_DmaInitialize(DMA_BYTES_PER_BURST, DMA_REQUEST_PER_BURST,
+                                           HI16(DMA_SRC_BASE), HI16(DMA_DST_BASE));
+        dmaTd[0] = CyDmaTdAllocate();
+        dmaTd[1] = CyDmaTdAllocate();
+    }
+
+    // TD0 fills the first half, TD1 the second, then back to TD0
+    (void)CyDmaTdSetConfiguration(dmaTd[0], ADC_STREAM_BLOCK * sizeof(uint16), dmaTd[1],
+                                  DMA_ADC__TD_TERMOUT_EN | CY_DMA_TD_INC_DST_ADR);
+    (void)CyDmaTdSetConfiguration(dmaTd[1], ADC_STREAM_BLOCK * sizeof(uint16), dmaTd[0],
+                                  DMA_ADC__TD_TERMOUT_EN | CY_DMA_TD_INC_DST_ADR);
+    (void)CyDmaTdSetAddress(dmaTd[0], LO16((uint32)ADC_SAR_WRK0_PTR), LO16((uint32)&ring[0]));
+    (void)CyDmaTdSetAddress(dmaTd[1], LO16((uint32)ADC_SAR_WRK0_PTR),
+                            LO16((uint32)&ring[ADC_STREAM_BLOCK]));
+    (void)CyDmaChSetInitialTd(dmaChannel, dmaTd[0]);
+
+    isr_DMA_ADC_StartEx(&AdcStream_DmaIsr);
+    (void)CyDmaChEnable(dmaChannel, 1u);
+#else
+    ADC_IRQ_Enable();
+#endif /* ADC_STREAM_USE_DMA */
+}
+
+void AdcStream_Stop(void)
+{
+    AdcStream_Pause();
+    Power_Release(POWER_NEED_ADC);
+}
+
+void AdcStream_Pause(void)
+{
+#if (ADC_STREAM_USE_DMA)
+    if (CY_DMA_INVALID_CHANNEL != dmaChannel)
+    {
+        (void)CyDmaChDisable(dmaChannel);
+    }
+    isr_DMA_ADC_Disable();
+#else
+    ADC_IRQ_Disable();
+#endif /* ADC_STREAM_USE_DMA */
+}
+
+void AdcStream_Resume(void)
+{
+#if (ADC_STREAM_USE_DMA)
+    // the channel keeps its place in the current TD while disabled
+    isr_DMA_ADC_Enable();
+    (void)CyDmaChEnable(dmaChannel, 1u);
+#else
+    ADC_IRQ_Enable();
+#endif /* ADC_STREAM_USE_DMA */
+}
+
+void AdcStream_SetCallback(adc_stream_callback_t callback)
+{
+    blockCallback = callback;
+}
+
+uint32 AdcStream_SampleCount(void)
+{
+    return written;
+}
+
+/*
+ * The newest block is only safe to read until the writer comes round to it
+ * again. The DMA refills a whole half at once so any new block means a retry;
+ * the ISR only overwrites the oldest slots, which may move by up to one
+ * block before the newest ADC_STREAM_BLOCK samples are touched.
+ */
+static uint8 AdcStream_Stable(uint32 start)
+{
+#if (ADC_STREAM_USE_DMA)
+    return (uint8)(written == start);
+#else
+    return (uint8)((written - start) <= (ADC_STREAM_SIZE - ADC_STREAM_BLOCK));
+#endif /* ADC_STREAM_USE_DMA */
+}
+
+static uint16 AdcStream_Clamp(uint32 start, uint16 count)
+{
+    if (count > ADC_STREAM_BLOCK)
+    {
+        count = ADC_STREAM_BLOCK;
+    }
+    if (count > start)
+    {
+        count = (uint16)start;
+    }
+    return count;
+}
+
+uint16 AdcStream_GetLatest(uint16 dst[], uint16 count)
+{
+    uint32 start;
+    uint16 i;
+
+    do
+    {
+        start = written;
+        count = AdcStream_Clamp(start, count);
+        for (i = 0u; i < count; i++)
+        {
+            dst[i] = ring[(start - count + i) & ADC_STREAM_MASK];
+        }
+    } while (0u == AdcStream_Stable(start));
+
+    return count;
+}
+
+static uint32 AdcStream_Sum(uint16 *count)
+{
+    uint32 start;
+    uint32 sum;
+    uint16 i;
+
+    do
+    {
+        start = written;
+        *count = AdcStream_Clamp(start, *count);
+        sum = 0u;
+        for (i = 0u; i < *count; i++)
+        {
+            sum += ring[(start - *count + i) & ADC_STREAM_MASK];
+        }
+    } while (0u == AdcStream_Stable(start));
+
+    return sum;
+}
+
+uint16 AdcStream_Average(uint16 count)
+{
+    uint32 sum = AdcStream_Sum(&count);
+
+    return (0u == count) ? 0u : (uint16)((sum + (count / 2u)) / count);
+}
+
+uint16 AdcStream_Oversample(uint8 extraBits)
+{
+    uint16 count;
+    uint32 sum;
+
+    if (extraBits > ADC_STREAM_MAX_EXTRA_BITS)
+    {
+        extraBits = ADC_STREAM_MAX_EXTRA_BITS;
+    }
+
+    // 4^k samples summed and shifted right by k give k extra bits
+    count = (uint16)(1u << (2u * extraBits));
+    sum = AdcStream_Sum(&count);
+    if (count < (uint16)(1u << (2u * extraBits)))
+    {
+        // not enough samples yet, scale what there is
+        return (0u == count) ? 0u : (uint16)((sum << extraBits) / count);
+    }
+
+    return (uint16)(sum >> extraBits);
+}
+
+/* [] END OF FILE */
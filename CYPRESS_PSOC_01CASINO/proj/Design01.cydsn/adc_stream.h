@@ -0,0 +1,81 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef ADC_STREAM_H
+#define ADC_STREAM_H
+
+#include "cytypes.h"
+
+/*
+ * Continuous ADC acquisition into a circular SRAM buffer.
+ *
+ * By default the ADC_ISR copies every conversion, which costs one interrupt
+ * per sample and needs nothing beyond the ADC already in the TopDesign.
+ *
+ * ADC_STREAM_USE_DMA moves the copy to DMA. It needs a DMA component named
+ * DMA_ADC with its drq wired to the ADC eoc terminal and an Interrupt named
+ * isr_DMA_ADC on the DMA_ADC nrq terminal. Neither is placed in the current
+ * TopDesign, so it is 0; set it to 1 once they are. Two chained TDs then
+ * fill the two halves of the buffer with no CPU work, and isr_DMA_ADC only
+ * runs once per half.
+ *
+ * Samples are raw SAR counts (ADC_shift is 0 for single-ended ranges).
+ */
+
+#ifndef ADC_STREAM_USE_DMA
+    #define ADC_STREAM_USE_DMA  (0u)
+#endif /* ADC_STREAM_USE_DMA */
+
+#define ADC_STREAM_SIZE         (256u)  // power of two
+#define ADC_STREAM_MASK         (ADC_STREAM_SIZE - 1u)
+#define ADC_STREAM_BLOCK        (ADC_STREAM_SIZE / 2u)
+
+// Largest oversample: 4^3 = 64 samples for 3 extra bits
+#define ADC_STREAM_MAX_EXTRA_BITS   (3u)
+
+/*
+ * Called from interrupt context each time half of the buffer is filled.
+ * block points into the ring and stays stable until the other half is
+ * filled, so copy out or finish quickly.
+ */
+typedef void (*adc_stream_callback_t)(const uint16 block[], uint16 count);
+
+// Holds POWER_NEED_ADC from Start to Stop.
+void AdcStream_Start(void);
+void AdcStream_Stop(void);
+
+// Stop and restart filling the ring without moving its position, so
+// AdcStream_SampleCount() carries on where it was. For AdcAcq_Burst(), which
+// reads the SAR itself meanwhile; POWER_NEED_ADC stays held.
+void AdcStream_Pause(void);
+void AdcStream_Resume(void);
+
+void AdcStream_SetCallback(adc_stream_callback_t callback);
+
+// Samples written since AdcStream_Start(), advances a block at a time with DMA.
+uint32 AdcStream_SampleCount(void);
+
+// Copies the newest count samples (oldest first), returns how many were copied.
+uint16 AdcStream_GetLatest(uint16 dst[], uint16 count);
+
+// Mean of the newest count samples.
+uint16 AdcStream_Average(uint16 count);
+
+// Oversample and decimate: result has ADC resolution + extraBits bits.
+uint16 AdcStream_Oversample(uint8 extraBits);
+
+#if (0u == ADC_STREAM_USE_DMA)
+    // Hooked into ADC_ISR through cyapicallbacks.h
+    void ADC_ISR_InterruptCallback(void);
+#endif /* ADC_STREAM_USE_DMA */
+
+#endif /* ADC_STREAM_H */
+/* [] END OF FILE */
@@ -16,6 +16,13 @@
     /*Define your macro callbacks here */
     /*For more information, refer to the Writing Code topic in the PSoC Creator Help.*/
 
+    #include "adc_stream.h"
+
+    /* Without DMA the ADC_ISR feeds the acquisition ring */
+    #if (0u == ADC_STREAM_USE_DMA)
+        #define ADC_ISR_INTERRUPT_CALLBACK
+    #endif /* ADC_STREAM_USE_DMA */
+
     
 #endif /* CYAPICALLBACKS_H */   
 /* [] */
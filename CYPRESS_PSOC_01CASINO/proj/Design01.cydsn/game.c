@@ -0,0 +1,178 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "game.h"
+
+// Indexed by game_state_t, timings follow the original CyDelay() sequence
+static const uint32 gameDwellMs[GAME_STATE_COUNT] =
+{
+    1000u,      // GAME_STATE_WELCOME
+    4000u,      // GAME_STATE_TURN
+    1000u,      // GAME_STATE_ROLL
+    6000u,      // GAME_STATE_MASTER
+    1000u,      // GAME_STATE_SCORE
+    1000u,      // GAME_STATE_REST
+    5000u,      // GAME_STATE_WINNER
+};
+
+// Rolls and scores one turn for the given player.
+static void Game_PlayTurn(game_t *game, uint8 index)
+{
+    player_t *player = &game->players[index];
+    uint8 roll = game->io->readKnob();
+
+    player->flags = 0u;
+
+    // unplayable knob values (0, 96 and 100 in the classic rules)
+    if (0u != Rules_IsReroll(game->rules, roll))
+    {
+        roll = game->io->random(game->rules->randomRolls) + 1u;
+        player->flags |= GAME_FLAG_REROLLED;
+    }
+    if (0u != Rules_IsMaster(game->rules, roll))
+    {
+        player->flags |= GAME_FLAG_MASTER;
+    }
+
+    player->lastRoll = roll;
+    player->score += Rules_Points(game->rules, roll);
+    if (game->maxScore < player->score)
+    {
+        game->maxScore = player->score;
+    }
+}
+
+static void Game_Enter(game_t *game, game_state_t state, uint32 nowMs)
+{
+    uint8 i;
+
+    game->state = state;
+    game->enteredMs = nowMs;
+
+    switch (state)
+    {
+        case GAME_STATE_WELCOME:
+            for (i = 0u; i < GAME_PLAYERS; i++)
+            {
+                game->players[i].score = 0u;
+                game->players[i].lastRoll = 0u;
+                game->players[i].flags = 0u;
+            }
+            game->maxScore = 0u;
+            game->player = 0u;
+            break;
+
+        case GAME_STATE_ROLL:
+            Game_PlayTurn(game, game->player);
+            break;
+
+        case GAME_STATE_WINNER:
+            game->winner = 0u;
+            for (i = 1u; i < GAME_PLAYERS; i++)
+            {
+                // ties go to the later player
+                if (game->players[i].score >= game->players[game->winner].score)
+                {
+                    game->winner = i;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    game->io->enter(game);
+}
+
+static game_state_t Game_Next(game_t *game)
+{
+    game_state_t next;
+
+    switch (game->state)
+    {
+        case GAME_STATE_WELCOME:
+            next = GAME_STATE_TURN;
+            break;
+
+        case GAME_STATE_TURN:
+            next = GAME_STATE_ROLL;
+            break;
+
+        case GAME_STATE_ROLL:
+            if (0u != (game->players[game->player].flags & GAME_FLAG_MASTER))
+            {
+                next = GAME_STATE_MASTER;
+            }
+            else
+            {
+                next = GAME_STATE_SCORE;
+            }
+            break;
+
+        case GAME_STATE_MASTER:
+            next = GAME_STATE_SCORE;
+            break;
+
+        case GAME_STATE_SCORE:
+            next = GAME_STATE_REST;
+            break;
+
+        case GAME_STATE_REST:
+            if (game->maxScore >= game->rules->targetScore)
+            {
+                next = GAME_STATE_WINNER;
+            }
+            else
+            {
+                game->player = (uint8)((game->player + 1u) % GAME_PLAYERS);
+                next = GAME_STATE_TURN;
+            }
+            break;
+
+        default:
+            next = GAME_STATE_WELCOME;
+            break;
+    }
+
+    return next;
+}
+
+void Game_Init(game_t *game, const game_io_t *io, const rules_t *rules, uint32 nowMs)
+{
+    game->io = io;
+    game->rules = rules;
+    game->winner = 0u;
+    Game_Enter(game, GAME_STATE_WELCOME, nowMs);
+}
+
+void Game_Run(game_t *game, uint32 nowMs)
+{
+    // Catch up state by state, each one starting exactly where the last ended
+    while ((uint32)(nowMs - game->enteredMs) >= gameDwellMs[game->state])
+    {
+        uint32 deadline = Game_NextDeadline(game);
+
+        Game_Enter(game, Game_Next(game), deadline);
+    }
+}
+
+uint32 Game_NextDeadline(const game_t *game)
+{
+    return game->enteredMs + gameDwellMs[game->state];
+}
+
+uint32 Game_DwellMs(game_state_t state)
+{
+    return gameDwellMs[state];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef GAME_H
+#define GAME_H
+
+#include "cytypes.h"
+#include "rules.h"
+
+/*
+ * Turn flow of the casino game as a state machine. Every state declares how
+ * long it stays on screen; Game_Run() is called from the main loop with the
+ * current time and only moves on once that dwell time has passed, so the
+ * CPU is free in between. The engine does no hardware access itself, the
+ * board (or a host replay) plugs in through game_io_t. Scoring comes from
+ * a rules_t table.
+ */
+
+#ifndef GAME_PLAYERS
+    #define GAME_PLAYERS    (2u)
+#endif /* GAME_PLAYERS */
+
+#if (GAME_PLAYERS < 1u) || (GAME_PLAYERS > 8u)
+    #error "GAME_PLAYERS must be 1..8"
+#endif
+
+// player_t.flags, describe the player's last turn
+#define GAME_FLAG_MASTER    (0x01u)     // the roll was a master move
+#define GAME_FLAG_REROLLED  (0x02u)     // the knob value was replaced
+
+typedef enum
+{
+    GAME_STATE_WELCOME = 0,     // scoreboard between games
+    GAME_STATE_TURN,            // "TURN: Px", player sets the knob
+    GAME_STATE_ROLL,            // knob sampled, roll shown
+    GAME_STATE_MASTER,          // prime roll, LED on
+    GAME_STATE_SCORE,           // new score shown, LED on
+    GAME_STATE_REST,            // LED off before the next turn
+    GAME_STATE_WINNER,
+    GAME_STATE_COUNT
+} game_state_t;
+
+typedef struct
+{
+    uint16 score;
+    uint8 lastRoll;             // 1..99, 0 before the first turn
+    uint8 flags;
+} player_t;
+
+typedef struct game_io game_io_t;
+
+typedef struct
+{
+    const game_io_t *io;
+    const rules_t *rules;
+    game_state_t state;
+    uint32 enteredMs;           // time the current state was entered
+    uint8 player;               // index of the player whose turn it is
+    uint8 winner;               // valid in GAME_STATE_WINNER
+    uint16 maxScore;
+    player_t players[GAME_PLAYERS];
+} game_t;
+
+struct game_io
+{
+    // Returns the knob position as a percentage, 0..100
+    uint8 (*readKnob)(void);
+    // Returns a random value in 0..range-1
+    uint8 (*random)(uint8 range);
+    // Called once on entry to every state, draws the screen and sets the LED
+    void (*enter)(const game_t *game);
+};
+
+void Game_Init(game_t *game, const game_io_t *io, const rules_t *rules, uint32 nowMs);
+
+// Advances the state machine, call whenever time moves on.
+void Game_Run(game_t *game, uint32 nowMs);
+
+// Absolute time at which the current state ends.
+uint32 Game_NextDeadline(const game_t *game);
+
+// Dwell time of a state in milliseconds.
+uint32 Game_DwellMs(game_state_t state);
+
+#endif /* GAME_H */
+/* [] END OF FILE */
@@ -0,0 +1,57 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef LCD_ASYNC_H
+#define LCD_ASYNC_H
+
+#include "cytypes.h"
+
+/*
+ * Queued, interrupt-driven writes to the character LCD. Bytes go into a ring
+ * and a timer interrupt clocks out one nibble per tick, so callers never spin
+ * on the busy flag. The tick is long enough for any normal HD44780 command;
+ * clear and home hold the queue for their full execution time instead of
+ * polling.
+ *
+ * Needs a Timer named LCD_Timer (1 MHz clock, period LCD_ASYNC_TICK_US) with
+ * its tc output on an Interrupt named isr_LCD. Neither is placed in the
+ * current TopDesign, so LCD_ASYNC_ENABLE is 0 and every call goes straight
+ * to the blocking LCD_WriteControl()/LCD_WriteData(); set it to 1 once they
+ * are. LCD_Start() must have finished before anything is queued.
+ */
+
+#ifndef LCD_ASYNC_ENABLE
+    #define LCD_ASYNC_ENABLE    (0u)
+#endif /* LCD_ASYNC_ENABLE */
+
+#define LCD_ASYNC_TICK_US       (50u)   // > 37 us command time, > 230 ns E pulse
+#define LCD_ASYNC_SLOW_CMD_US   (1520u) // clear display and return home
+#define LCD_ASYNC_QUEUE_SIZE    (128u)  // power of two
+
+typedef void (*lcd_async_callback_t)(void);
+
+void LcdAsync_Start(void);
+
+// Queue a command or a character; only waits if the queue is full.
+void LcdAsync_WriteControl(uint8 cByte);
+void LcdAsync_WriteData(uint8 dByte);
+void LcdAsync_Position(uint8 row, uint8 column);
+void LcdAsync_PrintString(char8 const string[]);
+
+// 1 once every queued byte has been clocked out and executed.
+uint8 LcdAsync_IsIdle(void);
+void LcdAsync_WaitIdle(void);
+
+// Called from the interrupt each time the queue drains.
+void LcdAsync_SetCallback(lcd_async_callback_t callback);
+
+#endif /* LCD_ASYNC_H */
+/* [] END OF FILE */
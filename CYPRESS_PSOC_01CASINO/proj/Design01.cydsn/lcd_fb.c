@@ -0,0 +1,221 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "lcd_async.h"
+#include "lcd_fb.h"
+
+#define LCD_FB_UNKNOWN  (0xFFu)
+
+static char8 shadow[LCD_FB_ROWS][LCD_FB_COLS];  // what the application drew
+static char8 shown[LCD_FB_ROWS][LCD_FB_COLS];   // what the display holds
+static char8 cleared[LCD_FB_ROWS][LCD_FB_COLS]; // blank, to cost a clear display
+
+static uint8 drawRow = 0u;
+static uint8 drawCol = 0u;
+
+// Display address counter, LCD_FB_UNKNOWN when it is off the visible area
+static uint8 lcdRow = LCD_FB_UNKNOWN;
+static uint8 lcdCol = LCD_FB_UNKNOWN;
+
+#if (LCD_FB_MEASURE_CYCLES)
+    static uint32 flushCycles = 0u;
+#endif /* LCD_FB_MEASURE_CYCLES */
+
+static void LcdFb_Fill(char8 cells[LCD_FB_ROWS][LCD_FB_COLS])
+{
+    uint8 row;
+    uint8 col;
+
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        for (col = 0u; col < LCD_FB_COLS; col++)
+        {
+            cells[row][col] = ' ';
+        }
+    }
+}
+
+void LcdFb_Init(void)
+{
+    LcdFb_Fill(shown);
+    LcdFb_Fill(cleared);
+    LcdFb_Clear();
+    lcdRow = LCD_FB_UNKNOWN;
+    lcdCol = LCD_FB_UNKNOWN;
+
+    LcdAsync_Start();
+
+    #if (LCD_FB_MEASURE_CYCLES)
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0u;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif /* LCD_FB_MEASURE_CYCLES */
+}
+
+void LcdFb_Clear(void)
+{
+    LcdFb_Fill(shadow);
+    drawRow = 0u;
+    drawCol = 0u;
+}
+
+void LcdFb_Position(uint8 row, uint8 column)
+{
+    drawRow = row;
+    drawCol = column;
+}
+
+void LcdFb_PutChar(char8 character)
+{
+    if ((drawRow < LCD_FB_ROWS) && (drawCol < LCD_FB_COLS))
+    {
+        shadow[drawRow][drawCol] = character;
+    }
+    if (drawCol < LCD_FB_COLS)
+    {
+        drawCol++;
+    }
+}
+
+void LcdFb_PrintString(char8 const string[])
+{
+    while ((char8)'\0' != *string)
+    {
+        LcdFb_PutChar(*string);
+        string++;
+    }
+}
+
+void LcdFb_PrintNumber(uint16 value)
+{
+    char8 digits[5];
+    uint8 count = 0u;
+
+    do
+    {
+        digits[count] = (char8)('0' + (value % 10u));
+        value /= 10u;
+        count++;
+    } while (0u != value);
+
+    while (0u != count)
+    {
+        count--;
+        LcdFb_PutChar(digits[count]);
+    }
+}
+
+/*
+ * Brings base up to the shadow starting from the given address counter and
+ * returns the bytes that takes. With send 0 it only counts, so the cost of
+ * two ways to get there can be compared first.
+ */
+static uint16 LcdFb_Update(char8 base[LCD_FB_ROWS][LCD_FB_COLS], uint8 curRow, uint8 curCol, uint8 send)
+{
+    uint16 bytes = 0u;
+    uint8 row;
+    uint8 col;
+
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        for (col = 0u; col < LCD_FB_COLS; col++)
+        {
+            if (shadow[row][col] == base[row][col])
+            {
+                continue;
+            }
+
+            /*
+             * Moving the address counter costs one command byte, the same as
+             * rewriting one unchanged cell, so a one-cell gap is written over.
+             */
+            if ((curRow == row) && (curCol < col) && ((col - curCol) == 1u))
+            {
+                if (0u != send)
+                {
+                    LcdAsync_WriteData((uint8)shadow[row][curCol]);
+                    base[row][curCol] = shadow[row][curCol];
+                }
+                bytes++;
+            }
+            else if ((curRow != row) || (curCol != col))
+            {
+                if (0u != send)
+                {
+                    LcdAsync_Position(row, col);
+                }
+                bytes++;
+            }
+
+            if (0u != send)
+            {
+                LcdAsync_WriteData((uint8)shadow[row][col]);
+                base[row][col] = shadow[row][col];
+            }
+            bytes++;
+
+            curRow = row;
+            curCol = col + 1u;
+            if (curCol >= LCD_FB_COLS)
+            {
+                // the counter runs into the hidden part of the DDRAM line
+                curRow = LCD_FB_UNKNOWN;
+                curCol = LCD_FB_UNKNOWN;
+            }
+        }
+    }
+
+    if (0u != send)
+    {
+        lcdRow = curRow;
+        lcdCol = curCol;
+    }
+    return bytes;
+}
+
+uint16 LcdFb_Flush(void)
+{
+    uint16 bytes = 0u;
+    #if (LCD_FB_MEASURE_CYCLES)
+        uint32 start = DWT->CYCCNT;
+    #endif /* LCD_FB_MEASURE_CYCLES */
+
+    // clearing first wins when most of the old text would be blanked cell by cell
+    if (((uint32)LcdFb_Update(cleared, 0u, 0u, 0u) + LCD_FB_CLEAR_COST) <
+        (uint32)LcdFb_Update(shown, lcdRow, lcdCol, 0u))
+    {
+        LcdAsync_WriteControl(LCD_CLEAR_DISPLAY);
+        LcdFb_Fill(shown);
+        lcdRow = 0u;
+        lcdCol = 0u;
+        bytes = 1u;
+    }
+
+    bytes += LcdFb_Update(shown, lcdRow, lcdCol, 1u);
+
+    #if (LCD_FB_MEASURE_CYCLES)
+        flushCycles = DWT->CYCCNT - start;
+    #endif /* LCD_FB_MEASURE_CYCLES */
+
+    return bytes;
+}
+
+#if (LCD_FB_MEASURE_CYCLES)
+
+uint32 LcdFb_LastFlushCycles(void)
+{
+    return flushCycles;
+}
+
+#endif /* LCD_FB_MEASURE_CYCLES */
+
+/* [] END OF FILE */
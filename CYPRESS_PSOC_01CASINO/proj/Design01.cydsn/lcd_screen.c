@@ -0,0 +1,91 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <stdarg.h>
+#include <stddef.h>
+#include "lcd_fb.h"
+#include "lcd_screen.h"
+
+static void LcdScreen_Render(const lcd_screen_t *screen, va_list args)
+{
+    char8 const *text;
+    uint8 row;
+
+    LcdFb_Clear();
+
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        text = screen->rows[row];
+        if (NULL == text)
+        {
+            continue;
+        }
+
+        LcdFb_Position(row, 0u);
+        while ((char8)'\0' != *text)
+        {
+            if ((char8)'%' != *text)
+            {
+                LcdFb_PutChar(*text);
+                text++;
+                continue;
+            }
+
+            text++;
+            switch (*text)
+            {
+                case 'u':
+                    LcdFb_PrintNumber((uint16)va_arg(args, unsigned int));
+                    break;
+
+                case 's':
+                    LcdFb_PrintString(va_arg(args, char8 const *));
+                    break;
+
+                case 'c':
+                    LcdFb_PutChar((char8)va_arg(args, int));
+                    break;
+
+                case '\0':
+                    // a lone '%' at the end of the row
+                    text--;
+                    break;
+
+                default:
+                    LcdFb_PutChar(*text);
+                    break;
+            }
+            text++;
+        }
+    }
+}
+
+void LcdScreen_Draw(const lcd_screen_t *screen, ...)
+{
+    va_list args;
+
+    va_start(args, screen);
+    LcdScreen_Render(screen, args);
+    va_end(args);
+}
+
+uint16 LcdScreen_Show(const lcd_screen_t *screen, ...)
+{
+    va_list args;
+
+    va_start(args, screen);
+    LcdScreen_Render(screen, args);
+    va_end(args);
+
+    return LcdFb_Flush();
+}
+
+/* [] END OF FILE */
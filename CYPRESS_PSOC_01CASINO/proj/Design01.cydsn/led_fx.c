@@ -0,0 +1,207 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "led_fx.h"
+
+/*
+ * Brightness tables, gamma 2.2 so the fades look even to the eye:
+ * breathe is 255 * ((1 - cos(2 pi i / 256)) / 2)^2.2, pulse holds full
+ * brightness for two steps and then decays as 255 * exp(-(i - 2) / 10)^2.2.
+ */
+static const uint8 ledFxOnSteps[1] = { 255u };
+
+static const uint8 ledFxBreatheSteps[256] =
+{
+      0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,
+      0u,   0u,   0u,   0u,   1u,   1u,   1u,   1u,   1u,   1u,   2u,   2u,   2u,   2u,   3u,   3u,
+      4u,   4u,   5u,   5u,   6u,   7u,   8u,   8u,   9u,  10u,  11u,  12u,  14u,  15u,  16u,  18u,
+     19u,  21u,  22u,  24u,  26u,  28u,  30u,  32u,  34u,  37u,  39u,  42u,  44u,  47u,  50u,  53u,
+     55u,  59u,  62u,  65u,  68u,  72u,  75u,  79u,  82u,  86u,  90u,  93u,  97u, 101u, 105u, 109u,
+    113u, 117u, 121u, 126u, 130u, 134u, 138u, 142u, 147u, 151u, 155u, 159u, 164u, 168u, 172u, 176u,
+    180u, 184u, 188u, 192u, 196u, 199u, 203u, 207u, 210u, 213u, 217u, 220u, 223u, 226u, 229u, 232u,
+    234u, 237u, 239u, 241u, 243u, 245u, 247u, 248u, 250u, 251u, 252u, 253u, 254u, 254u, 255u, 255u,
+    255u, 255u, 255u, 254u, 254u, 253u, 252u, 251u, 250u, 248u, 247u, 245u, 243u, 241u, 239u, 237u,
+    234u, 232u, 229u, 226u, 223u, 220u, 217u, 213u, 210u, 207u, 203u, 199u, 196u, 192u, 188u, 184u,
+    180u, 176u, 172u, 168u, 164u, 159u, 155u, 151u, 147u, 142u, 138u, 134u, 130u, 126u, 121u, 117u,
+    113u, 109u, 105u, 101u,  97u,  93u,  90u,  86u,  82u,  79u,  75u,  72u,  68u,  65u,  62u,  59u,
+     55u,  53u,  50u,  47u,  44u,  42u,  39u,  37u,  34u,  32u,  30u,  28u,  26u,  24u,  22u,  21u,
+     19u,  18u,  16u,  15u,  14u,  12u,  11u,  10u,   9u,   8u,   8u,   7u,   6u,   5u,   5u,   4u,
+      4u,   3u,   3u,   2u,   2u,   2u,   2u,   1u,   1u,   1u,   1u,   1u,   1u,   0u,   0u,   0u,
+      0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u
+};
+
+static const uint8 ledFxPulseSteps[64] =
+{
+    255u, 255u, 255u, 205u, 164u, 132u, 106u,  85u,  68u,  55u,  44u,  35u,  28u,  23u,  18u,  15u,
+     12u,   9u,   8u,   6u,   5u,   4u,   3u,   3u,   2u,   2u,   1u,   1u,   1u,   1u,   1u,   0u,
+      0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,
+      0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u
+};
+
+static const uint8 ledFxStrobeSteps[16] =
+{
+    255u, 255u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u,   0u
+};
+
+const ledfx_effect_t LedFx_on = { ledFxOnSteps, 1u };
+const ledfx_effect_t LedFx_breathe = { ledFxBreatheSteps, 256u };
+const ledfx_effect_t LedFx_pulse = { ledFxPulseSteps, 64u };
+const ledfx_effect_t LedFx_strobe = { ledFxStrobeSteps, 16u };
+
+static const ledfx_effect_t * volatile ledFxEffect = NULL;   // playing now
+static volatile uint32 ledFxPassesLeft = 0u;    // 0 loops until replaced
+static volatile uint8 ledFxCompleted = 0u;
+static ledfx_callback_t ledFxCallback = NULL;
+
+#if (LEDFX_ENABLE)
+
+#define DMA_BYTES_PER_BURST     (1u)
+#define DMA_REQUEST_PER_BURST   (1u)
+#define DMA_SRC_BASE            (CYDEV_FLASH_BASE)
+#define DMA_DST_BASE            (CYDEV_PERIPH_BASE)
+
+static uint8 dmaChannel = CY_DMA_INVALID_CHANNEL;
+static uint8 dmaTd = CY_DMA_INVALID_TD;
+
+// Points the DMA at a new table, NULL switches the LED off.
+static void LedFx_Run(const ledfx_effect_t *effect)
+{
+    (void)CyDmaChDisable(dmaChannel);
+    CyDmaClearPendingDrq(dmaChannel);
+
+    if (NULL == effect)
+    {
+        PWM_LED_WriteCompare(0u);
+        return;
+    }
+
+    // one table entry per PWM period, the TD loops back onto itself
+    PWM_LED_WriteCompare(effect->steps[0]);
+    (void)CyDmaTdSetConfiguration(dmaTd, effect->length, dmaTd,
+                                  DMA_LED__TD_TERMOUT_EN | CY_DMA_TD_INC_SRC_ADR);
+    (void)CyDmaTdSetAddress(dmaTd, LO16((uint32)effect->steps), LO16((uint32)PWM_LED_COMPARE1_LSB_PTR));
+    (void)CyDmaChSetInitialTd(dmaChannel, dmaTd);
+    (void)CyDmaChEnable(dmaChannel, 1u);
+}
+
+#else
+
+static void LedFx_Run(const ledfx_effect_t *effect)
+{
+    Pin_2_Write((NULL != effect) ? 1u : 0u);
+}
+
+#endif /* LEDFX_ENABLE */
+
+static uint32 LedFx_Passes(const ledfx_effect_t *effect, uint32 durationMs)
+{
+    uint32 passMs = (uint32)effect->length * LEDFX_STEP_MS;
+
+    return (durationMs + passMs - 1u) / passMs;
+}
+
+#if (LEDFX_ENABLE)
+
+// Runs once per pass of the table
+static CY_ISR(LedFx_Isr)
+{
+    const ledfx_effect_t *done = ledFxEffect;
+
+    if ((NULL == done) || (0u == ledFxPassesLeft))
+    {
+        return;
+    }
+
+    ledFxPassesLeft--;
+    if (0u == ledFxPassesLeft)
+    {
+        ledFxEffect = NULL;
+        ledFxCompleted++;
+        LedFx_Run(NULL);
+
+        if (NULL != ledFxCallback)
+        {
+            ledFxCallback(done);
+        }
+    }
+}
+
+#endif /* LEDFX_ENABLE */
+
+void LedFx_Start(void)
+{
+    ledFxEffect = NULL;
+    ledFxPassesLeft = 0u;
+
+#if (LEDFX_ENABLE)
+    if (CY_DMA_INVALID_CHANNEL == dmaChannel)
+    {
+        dmaChannel = DMA_LED_DmaInitialize(DMA_BYTES_PER_BURST, DMA_REQUEST_PER_BURST,
+                                           HI16(DMA_SRC_BASE), HI16(DMA_DST_BASE));
+        dmaTd = CyDmaTdAllocate();
+    }
+
+    PWM_LED_Start();
+    isr_LED_StartEx(&LedFx_Isr);
+#endif /* LEDFX_ENABLE */
+
+    LedFx_Run(NULL);
+}
+
+void LedFx_Play(const ledfx_effect_t *effect, uint32 durationMs)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    ledFxEffect = effect;
+    ledFxPassesLeft = LedFx_Passes(effect, durationMs);
+    LedFx_Run(effect);
+
+    CyExitCriticalSection(interruptState);
+}
+
+void LedFx_Off(void)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    ledFxEffect = NULL;
+    ledFxPassesLeft = 0u;
+    LedFx_Run(NULL);
+
+    CyExitCriticalSection(interruptState);
+}
+
+uint8 LedFx_IsIdle(void)
+{
+#if (LEDFX_ENABLE)
+    return (NULL == ledFxEffect) ? 1u : 0u;
+#else
+    return 1u;
+#endif /* LEDFX_ENABLE */
+}
+
+uint8 LedFx_TakeCompleted(void)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+    uint8 completed = ledFxCompleted;
+
+    ledFxCompleted = 0u;
+
+    CyExitCriticalSection(interruptState);
+    return completed;
+}
+
+void LedFx_SetCallback(ledfx_callback_t callback)
+{
+    ledFxCallback = callback;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,74 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef LED_FX_H
+#define LED_FX_H
+
+#include "cytypes.h"
+
+/*
+ * LED effects played by hardware. A PWM drives the LED and a DMA channel
+ * copies one entry of a brightness table in flash into its compare
+ * register at every PWM period, looping over the table on its own. The CPU
+ * only sees one interrupt per pass of the table, to count down the
+ * duration.
+ *
+ * Needs in TopDesign:
+ *  - a PWM named PWM_LED, 8-bit, period 255, clock LEDFX_PWM_CLOCK_HZ,
+ *    its pwm output on Pin_2 (set Pin_2 to HW connection)
+ *  - a DMA named DMA_LED with its drq on the PWM_LED tc terminal
+ *  - an Interrupt named isr_LED on the DMA_LED nrq terminal
+ * None of them is placed in the current TopDesign, so LEDFX_ENABLE is 0:
+ * every effect then just turns Pin_2 on until the next effect or
+ * LedFx_Off(), and nothing is ever reported as playing or completed. Set
+ * it to 1 once they are.
+ */
+
+#ifndef LEDFX_ENABLE
+    #define LEDFX_ENABLE        (0u)
+#endif /* LEDFX_ENABLE */
+
+#define LEDFX_PWM_CLOCK_HZ      (64000u)
+#define LEDFX_STEP_MS           (4u)    // one PWM period of 256 clocks
+
+typedef struct
+{
+    const uint8 *steps;         // compare values, one per LEDFX_STEP_MS
+    uint16 length;              // 1..256
+} ledfx_effect_t;
+
+extern const ledfx_effect_t LedFx_on;
+extern const ledfx_effect_t LedFx_breathe;     // 1 s sine fade in and out
+extern const ledfx_effect_t LedFx_pulse;       // 256 ms flash and decay
+extern const ledfx_effect_t LedFx_strobe;      // 15 Hz short flashes
+
+// Called from interrupt context when an effect has played for its duration.
+typedef void (*ledfx_callback_t)(const ledfx_effect_t *effect);
+
+void LedFx_Start(void);
+
+// Replaces whatever is playing. durationMs is rounded up to whole passes
+// of the table, 0 loops until something else is played.
+void LedFx_Play(const ledfx_effect_t *effect, uint32 durationMs);
+
+// Stops the effect and turns the LED off.
+void LedFx_Off(void);
+
+// 1 while nothing is playing.
+uint8 LedFx_IsIdle(void);
+
+// Number of effects finished since the last call.
+uint8 LedFx_TakeCompleted(void);
+
+void LedFx_SetCallback(ledfx_callback_t callback);
+
+#endif /* LED_FX_H */
+/* [] END OF FILE */
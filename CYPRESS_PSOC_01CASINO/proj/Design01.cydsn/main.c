@@ -1,246 +1,142 @@
 
-//ADC  LCD LED 
+//ADC  LCD LED
 
 #include "project.h"
-#include <stdio.h>
-#include<stdlib.h>
-#include <math.h>
-#include<time.h>
-#include <stdbool.h>
-#define LED_ON 1u
-#define LED_OFF 0u
-int main(void)
+#include "adc_acq.h"
+#include "adc_scale.h"
+#include "adc_stream.h"
+#include "game.h"
+#include "lcd_async.h"
+#include "lcd_fb.h"
+#include "led_fx.h"
+#include "power.h"
+#include "rng.h"
+#include "screens.h"
+#include "stats.h"
+#include "stats_eeprom.h"
+#include "tick.h"
+
+static rng_t rng;
+
+static uint8 ReadKnob(void)
 {
-    CyGlobalIntEnable;
-    unsigned int p1 = 0;
-    unsigned int p2 = 0;
-    unsigned int total_score = 50;
-    unsigned int current_max_score = 0;
-    unsigned int t1 = 0;
-    unsigned int t2 = 0;
-    unsigned int i;
-
-    srand(time(0));
-    int prime[400 + 1];
-    bool game_continue = true;
-    for (int i = 1; i <= 400; i++)
+    adc_acq_stats_t stats;
+    uint16 adc_reading;
+
+    // 64 settled 12-bit conversions, scaled back to the percent table's counts
+    AdcAcq_Burst(&AdcAcq_knob, &stats);
+    adc_reading = (uint16)((stats.meanQ8 + (1uL << (19u - ADC_SCALE_RESOLUTION))) >>
+                           (20u - ADC_SCALE_RESOLUTION));
+    if (adc_reading > ADC_SCALE_MAX_COUNT)
     {
-        prime[i] = i;
+        adc_reading = ADC_SCALE_MAX_COUNT;
     }
 
-    for (int i = 2; i * i <= 400; i++)
-    {
-        if (prime[i] != -1)
-        {
+    return AdcScale_ToPercent(adc_reading);
+}
 
-            for (int j = 2 * i; j <= 400; j += i)
-                prime[j] = -1;
-        }
-    }
-    ADC_Start();
-    ADC_StartConvert();
+static uint8 Random(uint8 range)
+{
+    return (uint8)Rng_Bounded(&rng, range);
+}
 
-    LCD_Start();
-    LCD_Position(0, 0);
-    while (current_max_score != total_score)
+// LED effect for each game_state_t, NULL for off
+static const ledfx_effect_t * const stateLeds[GAME_STATE_COUNT] =
+{
+    NULL,               // GAME_STATE_WELCOME
+    NULL,               // GAME_STATE_TURN
+    NULL,               // GAME_STATE_ROLL
+    &LedFx_strobe,      // GAME_STATE_MASTER
+    &LedFx_pulse,       // GAME_STATE_SCORE
+    NULL,               // GAME_STATE_REST
+    &LedFx_breathe,     // GAME_STATE_WINNER
+};
+
+static void EnterState(const game_t *game)
+{
+    // the effect runs on the PWM and DMA for the whole dwell time
+    if (NULL != stateLeds[game->state])
     {
-        game_continue = true;
-
-        LCD_Position(0, 4);
-        LCD_PrintString("Welcome");
-        LCD_Position(1, 2);
-        LCD_PrintString("P1: ");
-        LCD_PrintNumber(p1);
-        LCD_PutChar(' ');
-
-        LCD_PrintString("P2: ");
-        LCD_PrintNumber(p2);
+        LedFx_Play(stateLeds[game->state], Game_DwellMs(game->state));
+    }
+    else
+    {
+        LedFx_Off();
+    }
 
-        CyDelay(1000);
+    if (GAME_STATE_WINNER == game->state)
+    {
+        Stats_RecordGame(game);
+    }
 
-        LCD_ClearDisplay();
-        while (game_continue)
-        {
-            //LCD_Position(0, 4);
-            CyDelay(100);
-            LCD_ClearDisplay();
-            LCD_PrintString("TURN: P1 ");
+    (void)Screens_Show(game);
+}
 
-            CyDelay(2000);
+static const game_io_t gameIo =
+{
+    &ReadKnob,
+    &Random,
+    &EnterState
+};
 
-            for (i = 0; i < 2000; i++)
-            {
+int main(void)
+{
+    game_t game;
 
-                uint32 j;
-                for (j = 0; j < 6000; j++)
-                {
+    CyGlobalIntEnable;
 
-                    
-                }
-            }
-            ADC_IsEndConversion(ADC_WAIT_FOR_RESULT);
-            uint16 adc_reading = ADC_GetResult16();
-
-            t1 = ((int)adc_reading / 255.0) * 100.0;
-            //while(t1==0 || t1==96) t1=(rand()%96)+1;
-            if(t1==0 || t1==96|| t1==100) t1=(rand()%96)+1;
-            LCD_ClearDisplay();
-            LCD_Position(0, 4);
-            LCD_PrintNumber(t1);
-            CyDelay(1000);
-            LCD_ClearDisplay();
-
-            if (prime[t1] != -1)
-            {
+    // first, so the modules below can take their power needs as they start
+    Power_Init();
+    ADC_Start();
+    ADC_StartConvert();
+    AdcAcq_Init();
+    AdcStream_Start();
 
-                CyDelay(1000);
-
-                LCD_ClearDisplay();
-                LCD_Position(0, 0);
-                LCD_PrintString("MASTER MOVE: P1!!");
-                Pin_2_Write(LED_ON);
-                CyDelay(6000);
-                Pin_2_Write(LED_OFF);
-               
-                p1 += 20;
-                LCD_PrintString("P1: ");
-                LCD_PrintNumber(p1);
-
-                CyDelay(1000);
-                LCD_ClearDisplay();
-            }
-            else
-            {
-                LCD_ClearDisplay();
-                LCD_Position(0, 4);
-                LCD_PrintString("P1: ");
-                p1 += 7;
-                LCD_PrintNumber(p1);
-            }
+    LCD_Start();
+    LcdFb_Init();
+    LedFx_Start();
+    Tick_Start();
+    // after Tick_Start(), the seed takes the SysTick count at each ADC block
+    Rng_SeedFromHardware(&rng);
+    Power_ResetStats();
+    Stats_Init(StatsEeprom_Start());
+
+    Game_Init(&game, &gameIo, &Rules_classic, Tick_GetMs());
+    Power_SetDeadline(POWER_TIMER_GAME, Game_NextDeadline(&game));
+    for (;;)
+    {
+        if (0u != Tick_Pending())
+        {
+            Game_Run(&game, Tick_GetMs());
+            Power_SetDeadline(POWER_TIMER_GAME, Game_NextDeadline(&game));
 
-            if (current_max_score < p1)
+            // flash writes stall the CPU, only let them happen between games
+            if ((GAME_STATE_WINNER == game.state) || (GAME_STATE_WELCOME == game.state))
             {
-                current_max_score = p1;
-            }
-            
-            
-            // TODO: PWM LIGHT
-            //TODO:
-            Pin_2_Write(LED_ON);
-                CyDelay(1000);
-            Pin_2_Write(LED_OFF);
-            
-            CyDelay(1000);
-            if (current_max_score < total_score)
-            {
-                LCD_ClearDisplay();
-                CyDelay(1000);
-                LCD_PrintString("TURN: P2 ");
-
-                CyDelay(2000);
-
-                for (i = 0; i < 2000; i++)
-                {
-
-                    uint32 j;
-                    for (j = 0; j < 6000; j++)
-                    {
-
-                       
-                    }
-                }
-                ADC_IsEndConversion(ADC_WAIT_FOR_RESULT);
-                uint16 adc_reading = ADC_GetResult16();
-
-                t2 = ((int)adc_reading / 255.0) * 100.0;
-                //while(t2==0 || t2==96) t2=(rand()%96)+1;
-                if(t2==0 || t2==96|| t2==100) t2=(rand()%96)+1;
-                LCD_ClearDisplay();
-                LCD_Position(0, 4);
-                LCD_PrintNumber(t2);
-                CyDelay(1000);
-                LCD_ClearDisplay();
-
-                if (prime[t2] != -1)
-                {
-
-                    CyDelay(1000);
-
-                    LCD_ClearDisplay();
-                    LCD_Position(0, 0);
-                    LCD_PrintString("MASTER MOVE: P2!!");
-                    Pin_2_Write(LED_ON);
-                CyDelay(6000);
-                Pin_2_Write(LED_OFF);
-                
-                LCD_Position(1, 4);
-                    p2 += 20;
-                    LCD_PrintString("P2: ");
-                    LCD_PrintNumber(p2);
-
-                    CyDelay(1000);
-                    LCD_ClearDisplay();
-                }
-                else
-                {
-                    LCD_ClearDisplay();
-                    LCD_Position(0, 4);
-                    LCD_PrintString("P2: ");
-                    p2 += 7;
-                    LCD_PrintNumber(p2);
-                }
-
-                if (current_max_score < p2)
-                    current_max_score = p2;
-
-                CyDelay(1000);
-
-                  
-                
-                
-                // game end
-                Pin_2_Write(LED_ON);
-                CyDelay(1000);
-                Pin_2_Write(LED_OFF);
+                Stats_Service(Tick_GetMs());
             }
+        }
 
-            if (current_max_score >= total_score)
-            {
-                if (p1 > p2)
-                {
-
-                    LCD_ClearDisplay();
-                    LCD_Position(1, 4);
-                    LCD_PrintString("Winner: P1 :))");
-                    CyDelay(5000);
-                    LCD_ClearDisplay();
-                }
-                else
-                {
-
-                    LCD_ClearDisplay();
-                    LCD_Position(1, 4);
-                    LCD_PrintString("Winner: P2 :))");
-                    CyDelay(5000);
-                    LCD_ClearDisplay();
-                }
-
-                p1 = 0;
-                p2 = 0;
-                current_max_score = 0;
-                game_continue = false;
-                break;
-            }
-            else
-            {
-                continue;
-            }
+        if (0u != LcdAsync_IsIdle())
+        {
+            Power_Release(POWER_NEED_LCD);
+        }
+        else
+        {
+            Power_Require(POWER_NEED_LCD);
         }
-        if (!game_continue)
+        if (0u != LedFx_IsIdle())
         {
-            continue;
+            Power_Release(POWER_NEED_LED);
         }
+        else
+        {
+            Power_Require(POWER_NEED_LED);
+        }
+
+        // sleep until the next state change, the knob is sampled after waking
+        (void)Power_Idle();
     }
 }
 
-/* [] END OF FILE */
\ No newline at end of file
+/* [] END OF FILE */
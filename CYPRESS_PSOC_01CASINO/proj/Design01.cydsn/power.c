@@ -0,0 +1,238 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "power.h"
+#include "tick.h"
+
+// CyPmCtwSetInterval() value n gives a 2^(n+1) ms period
+#define POWER_CTW_MAX_INTERVAL  (11u)
+
+// needs whose clocks or interrupts stop in Sleep
+#define POWER_NO_SLEEP          (POWER_NEED_ADC | POWER_NEED_USB | POWER_NEED_LED)
+
+static uint32 powerDeadline[POWER_TIMER_COUNT];
+static uint8 powerDeadlineSet = 0u;         // bit per power_timer_t
+static volatile power_need_t powerNeeds = 0u;
+static uint16 powerWakeSources = PM_SLEEP_SRC_NONE;
+static power_stats_t powerStats;
+static uint32 powerLastUs;                  // end of the last accounted period
+
+#if (POWER_SLEEP_ENABLE)
+    static CY_ISR(Power_CtwIsr)
+    {
+        // clears the CTW event so the next Sleep waits a full interval
+        (void)CyPmReadStatus(CY_PM_CTW_INT);
+    }
+#endif /* POWER_SLEEP_ENABLE */
+
+static void Power_Account(power_mode_t mode, uint32 startUs)
+{
+    uint32 nowUs = Tick_GetUs();
+
+    // whatever ran since the last idle counts as Active
+    powerStats.timeUs[POWER_MODE_ACTIVE] += (uint32)(startUs - powerLastUs);
+    powerStats.timeUs[mode] += (uint32)(nowUs - startUs);
+    powerStats.entries[mode]++;
+    powerLastUs = nowUs;
+}
+
+// Milliseconds until the earliest deadline, 0xFFFFFFFF if there is none.
+static uint32 Power_TimeLeft(uint32 nowMs)
+{
+    uint32 left = 0xFFFFFFFFu;
+    uint32 until;
+    uint8 i;
+
+    for (i = 0u; i < POWER_TIMER_COUNT; i++)
+    {
+        if (0u != (powerDeadlineSet & (1u << i)))
+        {
+            until = powerDeadline[i] - nowMs;
+            // a deadline in the past shows up as a huge unsigned gap
+            if (until > 0x7FFFFFFFu)
+            {
+                until = 0u;
+            }
+            if (until < left)
+            {
+                left = until;
+            }
+        }
+    }
+
+    return left;
+}
+
+static power_mode_t Power_AltActive(void)
+{
+    uint8 adcStby = CY_GET_REG8(ADC_ADC_SAR__PM_STBY_CFG);
+    uint8 clkStby = CY_GET_REG8(ADC_theACLK__PM_STBY_CFG);
+
+    // the SAR and its clock stop unless someone is sampling
+    if (0u == (powerNeeds & POWER_NEED_ADC))
+    {
+        CY_SET_REG8(ADC_ADC_SAR__PM_STBY_CFG, adcStby & (uint8)~ADC_ADC_SAR__PM_STBY_MSK);
+        CY_SET_REG8(ADC_theACLK__PM_STBY_CFG, clkStby & (uint8)~ADC_theACLK__PM_STBY_MSK);
+    }
+
+    // the next SysTick or DMA interrupt brings it back
+    CyPmAltAct(PM_ALT_ACT_TIME_NONE, PM_ALT_ACT_SRC_INTERRUPT);
+
+    CY_SET_REG8(ADC_ADC_SAR__PM_STBY_CFG, adcStby);
+    CY_SET_REG8(ADC_theACLK__PM_STBY_CFG, clkStby);
+    return POWER_MODE_ALT_ACTIVE;
+}
+
+#if (POWER_SLEEP_ENABLE)
+    static power_mode_t Power_Sleep(uint32 sleepMs)
+    {
+        uint8 interval = POWER_CTW_MAX_INTERVAL;
+        uint32 periodMs = POWER_CTW_MAX_MS;
+        uint8 woke;
+
+        // largest 2^(n+1) ms period that fits
+        while (periodMs > sleepMs)
+        {
+            periodMs >>= 1u;
+            interval--;
+        }
+
+        CyPmCtwSetInterval(interval);
+        CY_PM_TW_CFG2_REG |= (CY_PM_CTW_IE | CY_PM_CTW_EN);
+        (void)CyPmReadStatus(CY_PM_CTW_INT);
+
+        ADC_Sleep();
+        CyPmSaveClocks();
+        CyPmSleep(PM_SLEEP_TIME_NONE, PM_SLEEP_SRC_CTW | powerWakeSources);
+        CyPmRestoreClocks();
+        ADC_Wakeup();
+
+        // SysTick was stopped, credit the interval if the CTW ended the sleep
+        woke = CyPmReadStatus(CY_PM_CTW_INT);
+        CY_PM_TW_CFG2_REG &= (uint8)~(CY_PM_CTW_IE | CY_PM_CTW_EN);
+        if (0u != (woke & CY_PM_CTW_INT))
+        {
+            Tick_Advance(periodMs);
+        }
+
+        return POWER_MODE_SLEEP;
+    }
+#endif /* POWER_SLEEP_ENABLE */
+
+void Power_Init(void)
+{
+    powerDeadlineSet = 0u;
+    powerNeeds = 0u;
+    powerWakeSources = PM_SLEEP_SRC_NONE;
+    Power_ResetStats();
+
+    #if (POWER_SLEEP_ENABLE)
+        isr_CTW_StartEx(&Power_CtwIsr);
+    #endif /* POWER_SLEEP_ENABLE */
+}
+
+void Power_SetDeadline(power_timer_t timer, uint32 atMs)
+{
+    powerDeadline[timer] = atMs;
+    powerDeadlineSet |= (uint8)(1u << timer);
+}
+
+void Power_ClearDeadline(power_timer_t timer)
+{
+    powerDeadlineSet &= (uint8)~(1u << timer);
+}
+
+void Power_Require(power_need_t needs)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    powerNeeds |= needs;
+
+    CyExitCriticalSection(interruptState);
+}
+
+void Power_Release(power_need_t needs)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    powerNeeds &= (power_need_t)~needs;
+
+    CyExitCriticalSection(interruptState);
+}
+
+void Power_SetWakeSources(uint16 sources)
+{
+    powerWakeSources = sources;
+}
+
+power_mode_t Power_Idle(void)
+{
+    uint32 startUs = Tick_GetUs();
+    uint32 left = Power_TimeLeft(Tick_GetMs());
+    power_mode_t mode;
+
+    if (left > POWER_WAKE_GUARD_MS)
+    {
+        left -= POWER_WAKE_GUARD_MS;
+    }
+    else
+    {
+        left = 0u;
+    }
+
+    if (0u != (powerNeeds & POWER_NEED_LCD))
+    {
+        // the LCD timer interrupt needs the full clock tree
+        __WFI();
+        mode = POWER_MODE_ACTIVE;
+    }
+    #if (POWER_SLEEP_ENABLE)
+        else if ((left >= POWER_SLEEP_MIN_MS) && (0u == (powerNeeds & POWER_NO_SLEEP)))
+        {
+            mode = Power_Sleep(left);
+        }
+    #endif /* POWER_SLEEP_ENABLE */
+    else if (left >= POWER_ALT_ACT_MIN_MS)
+    {
+        mode = Power_AltActive();
+    }
+    else
+    {
+        __WFI();
+        mode = POWER_MODE_ACTIVE;
+    }
+
+    Power_Account(mode, startUs);
+    return mode;
+}
+
+void Power_GetStats(power_stats_t *stats)
+{
+    uint32 nowUs = Tick_GetUs();
+
+    *stats = powerStats;
+    stats->timeUs[POWER_MODE_ACTIVE] += (uint32)(nowUs - powerLastUs);
+}
+
+void Power_ResetStats(void)
+{
+    uint8 i;
+
+    for (i = 0u; i < POWER_MODE_COUNT; i++)
+    {
+        powerStats.timeUs[i] = 0u;
+        powerStats.entries[i] = 0u;
+    }
+    powerLastUs = Tick_GetUs();
+}
+
+/* [] END OF FILE */
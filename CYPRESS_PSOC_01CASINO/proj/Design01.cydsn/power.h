@@ -0,0 +1,104 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef POWER_H
+#define POWER_H
+
+#include "cytypes.h"
+
+/*
+ * Low-power idle for the main loop. Modules post the next time they need
+ * the CPU (power_timer_t) and hold a power_need_t while they have work in
+ * flight; Power_Idle() then picks the deepest mode that wakes up in time:
+ *
+ *  - Active: plain WFI, when something is busy or the gap is tiny
+ *  - Alternate Active: CPU halted, blocks in the standby config keep
+ *    running, any interrupt (SysTick included) wakes it
+ *  - Sleep: clocks saved and stopped, the central timewheel (CTW) wakes
+ *    the part after the largest power-of-two interval that still ends
+ *    POWER_WAKE_GUARD_MS before the earliest deadline
+ *
+ * SysTick stops in Sleep, so the CTW interval is added back with
+ * Tick_Advance(). The CTW runs from the 1 kHz ILO, so a long sleep is only
+ * as accurate as the ILO, and a sleep cut short by another wakeup source
+ * is not credited at all.
+ *
+ * Sleep needs an Interrupt named isr_CTW on a Global Signal Reference set
+ * to "Central timewheel (ctw_int)" in TopDesign. It is not placed in the
+ * current TopDesign, so POWER_SLEEP_ENABLE is 0 and Power_Idle() never goes
+ * deeper than Alternate Active; set it to 1 once it is.
+ *
+ * Call Power_Init() before the modules that take needs as they start, such
+ * as AdcStream_Start().
+ */
+
+#ifndef POWER_SLEEP_ENABLE
+    #define POWER_SLEEP_ENABLE      (0u)
+#endif /* POWER_SLEEP_ENABLE */
+
+#define POWER_WAKE_GUARD_MS         (4u)    // clock restore plus a fresh ADC block
+#define POWER_ALT_ACT_MIN_MS        (2u)    // shorter gaps just WFI
+#define POWER_SLEEP_MIN_MS          (16u)   // shorter gaps are not worth the clock restore
+#define POWER_CTW_MAX_MS            (4096u)
+
+typedef enum
+{
+    POWER_MODE_ACTIVE = 0,
+    POWER_MODE_ALT_ACTIVE,
+    POWER_MODE_SLEEP,
+    POWER_MODE_COUNT
+} power_mode_t;
+
+// Deadline slots, one per module that schedules wakeups. The casino's LED
+// changes, screen redraws and turn timeouts all happen on game state changes.
+typedef enum
+{
+    POWER_TIMER_GAME = 0,
+    POWER_TIMER_COUNT
+} power_timer_t;
+
+// power_need_t bits: work that must not be stopped by Sleep
+#define POWER_NEED_LCD      (0x01u)     // LCD queue being clocked out
+#define POWER_NEED_ADC      (0x02u)     // ADC samples are being collected
+#define POWER_NEED_USB      (0x04u)     // USB traffic, needs the bus clocks
+#define POWER_NEED_LED      (0x08u)     // PWM/DMA LED effect playing
+
+typedef uint8 power_need_t;
+
+typedef struct
+{
+    uint64 timeUs[POWER_MODE_COUNT];
+    uint32 entries[POWER_MODE_COUNT];   // Active counts the WFI waits
+} power_stats_t;
+
+void Power_Init(void);
+
+// Sets or clears the next wakeup of a timer slot.
+void Power_SetDeadline(power_timer_t timer, uint32 atMs);
+void Power_ClearDeadline(power_timer_t timer);
+
+void Power_Require(power_need_t needs);
+void Power_Release(power_need_t needs);
+
+// Extra wakeup sources for Sleep, PM_SLEEP_SRC_* e.g. PM_SLEEP_SRC_PICU
+// for pin interrupts. The CTW is always included.
+void Power_SetWakeSources(uint16 sources);
+
+// Waits in the deepest mode that is back before the earliest deadline,
+// returns the mode it used. Interrupts must be enabled.
+power_mode_t Power_Idle(void);
+
+// Time spent in each mode since Power_Init() or the last reset.
+void Power_GetStats(power_stats_t *stats);
+void Power_ResetStats(void);
+
+#endif /* POWER_H */
+/* [] END OF FILE */
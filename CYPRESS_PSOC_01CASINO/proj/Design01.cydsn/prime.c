@@ -0,0 +1,59 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "prime.h"
+
+/*
+ * The table is built by the preprocessor instead of a sieve at boot, so it
+ * costs no stack and no startup time. Trial division by every prime up to 61
+ * is exact for all n < 67 * 67 = 4489, which covers PRIME_TABLE_MAX.
+ */
+#define PT_NDIV(n, p)   ((((n) % (p)) != 0u) || ((n) == (p)))
+
+#define PT_IS_PRIME(n)  (((n) > 1u) && \
+    PT_NDIV(n, 2u)  && PT_NDIV(n, 3u)  && PT_NDIV(n, 5u)  && PT_NDIV(n, 7u)  && \
+    PT_NDIV(n, 11u) && PT_NDIV(n, 13u) && PT_NDIV(n, 17u) && PT_NDIV(n, 19u) && \
+    PT_NDIV(n, 23u) && PT_NDIV(n, 29u) && PT_NDIV(n, 31u) && PT_NDIV(n, 37u) && \
+    PT_NDIV(n, 41u) && PT_NDIV(n, 43u) && PT_NDIV(n, 47u) && PT_NDIV(n, 53u) && \
+    PT_NDIV(n, 59u) && PT_NDIV(n, 61u))
+
+#define PT_BIT(n, b)    ((uint8)(PT_IS_PRIME((n) + (b)) ? (1u << (b)) : 0u))
+
+#define PT_BYTE(i)      (uint8)(PT_BIT((i) * 8u, 0u) | PT_BIT((i) * 8u, 1u) | \
+                                PT_BIT((i) * 8u, 2u) | PT_BIT((i) * 8u, 3u) | \
+                                PT_BIT((i) * 8u, 4u) | PT_BIT((i) * 8u, 5u) | \
+                                PT_BIT((i) * 8u, 6u) | PT_BIT((i) * 8u, 7u))
+
+#define PT_BYTES_4(i)   PT_BYTE(i), PT_BYTE((i) + 1u), PT_BYTE((i) + 2u), PT_BYTE((i) + 3u)
+#define PT_BYTES_16(i)  PT_BYTES_4(i), PT_BYTES_4((i) + 4u), \
+                        PT_BYTES_4((i) + 8u), PT_BYTES_4((i) + 12u)
+#define PT_BYTES_64(i)  PT_BYTES_16(i), PT_BYTES_16((i) + 16u), \
+                        PT_BYTES_16((i) + 32u), PT_BYTES_16((i) + 48u)
+#define PT_BYTES_256(i) PT_BYTES_64(i), PT_BYTES_64((i) + 64u), \
+                        PT_BYTES_64((i) + 128u), PT_BYTES_64((i) + 192u)
+
+const uint8 CYCODE Prime_table[PRIME_TABLE_BYTES] =
+{
+    PT_BYTES_256(0u),
+    PT_BYTES_256(256u)
+};
+
+uint8 Prime_IsPrime(uint16 n)
+{
+    if (n > PRIME_TABLE_MAX)
+    {
+        return 0u;
+    }
+
+    return (uint8)((Prime_table[n >> 3u] >> (n & 7u)) & 1u);
+}
+
+/* [] END OF FILE */
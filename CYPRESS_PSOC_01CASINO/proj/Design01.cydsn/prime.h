@@ -0,0 +1,28 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef PRIME_H
+#define PRIME_H
+
+#include "cytypes.h"
+
+// Largest value covered by the flash prime table.
+#define PRIME_TABLE_MAX     (4095u)
+#define PRIME_TABLE_BYTES   ((PRIME_TABLE_MAX + 1u) / 8u)
+
+// One bit per number, bit (n & 7) of byte (n >> 3) is set when n is prime.
+extern const uint8 CYCODE Prime_table[PRIME_TABLE_BYTES];
+
+// Returns 1 if n is prime, 0 otherwise (also 0 above PRIME_TABLE_MAX).
+uint8 Prime_IsPrime(uint16 n);
+
+#endif /* PRIME_H */
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "rng.h"
+
+#if (RNG_HARDWARE_SEED)
+    #include "project.h"
+    #include "adc_stream.h"
+#endif /* RNG_HARDWARE_SEED */
+
+#define RNG_MULTIPLIER      (6364136223846793005ull)
+#define RNG_GOLDEN          (0x9E3779B97F4A7C15ull)
+
+// Samples per ADC block whose two LSBs go into the seed
+#define RNG_SEED_SAMPLES    (32u)
+
+void Rng_Seed(rng_t *rng, uint64 seed, uint64 stream)
+{
+    rng->state = 0u;
+    rng->inc = (stream << 1u) | 1u;
+    (void)Rng_Next(rng);
+    rng->state += seed;
+    (void)Rng_Next(rng);
+}
+
+uint32 Rng_Next(rng_t *rng)
+{
+    uint64 old = rng->state;
+    uint32 xorshifted;
+    uint32 rot;
+
+    rng->state = (old * RNG_MULTIPLIER) + rng->inc;
+    xorshifted = (uint32)(((old >> 18u) ^ old) >> 27u);
+    rot = (uint32)(old >> 59u);
+
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+/*
+ * Lemire's multiply-shift: the high word of x * range is uniform once the
+ * few low words below (2^32 mod range) are rejected. The division to find
+ * that threshold only runs in the rare case the low word is small.
+ */
+uint32 Rng_Bounded(rng_t *rng, uint32 range)
+{
+    uint64 m = (uint64)Rng_Next(rng) * range;
+    uint32 low = (uint32)m;
+
+    if (low < range)
+    {
+        uint32 threshold = (uint32)(0u - range) % range;
+
+        while (low < threshold)
+        {
+            m = (uint64)Rng_Next(rng) * range;
+            low = (uint32)m;
+        }
+    }
+
+    return (uint32)(m >> 32u);
+}
+
+void Rng_Fill(rng_t *rng, uint32 dst[], uint16 count)
+{
+    uint16 i;
+
+    for (i = 0u; i < count; i++)
+    {
+        dst[i] = Rng_Next(rng);
+    }
+}
+
+void Rng_FillBounded(rng_t *rng, uint8 dst[], uint16 count, uint8 range)
+{
+    uint16 i;
+
+    for (i = 0u; i < count; i++)
+    {
+        dst[i] = (uint8)Rng_Bounded(rng, range);
+    }
+}
+
+#if (RNG_HARDWARE_SEED)
+
+static uint64 Rng_Mix(uint64 hash, uint32 value)
+{
+    hash ^= value;
+    hash *= RNG_GOLDEN;
+    return hash ^ (hash >> 29u);
+}
+
+void Rng_SeedFromHardware(rng_t *rng)
+{
+    uint16 samples[RNG_SEED_SAMPLES];
+    uint32 uniqueId[2];
+    uint32 start;
+    uint32 lsbs;
+    uint64 hash = RNG_GOLDEN;
+    uint8 block;
+    uint16 i;
+
+    CyGetUniqueId(uniqueId);
+
+    for (block = 0u; block < RNG_SEED_BLOCKS; block++)
+    {
+        // wait for a fresh block so no sample is counted twice
+        start = AdcStream_SampleCount();
+        while ((AdcStream_SampleCount() - start) < ADC_STREAM_BLOCK)
+        {
+        }
+
+        (void)AdcStream_GetLatest(samples, RNG_SEED_SAMPLES);
+        lsbs = 0u;
+        for (i = 0u; i < RNG_SEED_SAMPLES; i++)
+        {
+            // only the two noisy LSBs, 16 samples per word
+            lsbs = (lsbs << 2u) | (samples[i] & 3u);
+            if (15u == (i & 15u))
+            {
+                hash = Rng_Mix(hash, lsbs);
+            }
+        }
+
+        hash = Rng_Mix(hash, CY_SYS_SYST_CVR_REG);
+    }
+
+    Rng_Seed(rng, hash, ((uint64)uniqueId[1] << 32u) | uniqueId[0]);
+}
+
+#endif /* RNG_HARDWARE_SEED */
+
+/* [] END OF FILE */
@@ -0,0 +1,55 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef RNG_H
+#define RNG_H
+
+#include "cytypes.h"
+
+/*
+ * PCG32 (XSH RR) random number generator. Each rng_t is independent, so
+ * there is no hidden global state like newlib's rand().
+ *
+ * RNG_HARDWARE_SEED pulls in Rng_SeedFromHardware(); define it to 0 to
+ * build the generator on its own, e.g. on a PC.
+ */
+#ifndef RNG_HARDWARE_SEED
+    #define RNG_HARDWARE_SEED   (1u)
+#endif /* RNG_HARDWARE_SEED */
+
+// Number of ADC blocks whose samples are folded into the seed
+#define RNG_SEED_BLOCKS     (4u)
+
+typedef struct
+{
+    uint64 state;
+    uint64 inc;         // stream selector, always odd
+} rng_t;
+
+void Rng_Seed(rng_t *rng, uint64 seed, uint64 stream);
+
+#if (RNG_HARDWARE_SEED)
+    // Seeds from the LSBs of RNG_SEED_BLOCKS ADC blocks, the die unique ID
+    // and the SysTick count as each block lands. AdcStream_Start() and
+    // Tick_Start() must have been called, or the SysTick input is constant.
+    void Rng_SeedFromHardware(rng_t *rng);
+#endif /* RNG_HARDWARE_SEED */
+
+uint32 Rng_Next(rng_t *rng);
+
+// Uniform value in 0..range-1 without modulo bias, range must be > 0.
+uint32 Rng_Bounded(rng_t *rng, uint32 range);
+
+void Rng_Fill(rng_t *rng, uint32 dst[], uint16 count);
+void Rng_FillBounded(rng_t *rng, uint8 dst[], uint16 count, uint8 range);
+
+#endif /* RNG_H */
+/* [] END OF FILE */
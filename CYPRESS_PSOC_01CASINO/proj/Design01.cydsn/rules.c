@@ -0,0 +1,82 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "rules.h"
+#include "prime.h"
+
+const rules_t Rules_classic =
+{
+    "classic", 50u, 20u, 7u, 99u, 96u, 2u, { 0u, 96u }
+};
+
+static const rules_t rulesLong =
+{
+    "long", 100u, 20u, 7u, 99u, 96u, 2u, { 0u, 96u }
+};
+
+static const rules_t rulesFlat =
+{
+    "flat", 50u, 10u, 10u, 99u, 96u, 2u, { 0u, 96u }
+};
+
+static const rules_t rulesHalfMaster =
+{
+    "half-master", 50u, 14u, 7u, 99u, 96u, 2u, { 0u, 96u }
+};
+
+// every knob value plays, a reroll is never needed
+static const rules_t rulesNoReroll =
+{
+    "no-reroll", 50u, 20u, 7u, 100u, 100u, 0u, { 0u }
+};
+
+const rules_t * const Rules_table[] =
+{
+    &Rules_classic,
+    &rulesLong,
+    &rulesFlat,
+    &rulesHalfMaster,
+    &rulesNoReroll,
+};
+
+const uint8 Rules_count = (uint8)(sizeof(Rules_table) / sizeof(Rules_table[0]));
+
+uint8 Rules_IsReroll(const rules_t *rules, uint8 knob)
+{
+    uint8 i;
+
+    if (knob > rules->maxRoll)
+    {
+        return 1u;
+    }
+    for (i = 0u; i < rules->rerollCount; i++)
+    {
+        if (knob == rules->rerolls[i])
+        {
+            return 1u;
+        }
+    }
+
+    return 0u;
+}
+
+uint8 Rules_IsMaster(const rules_t *rules, uint8 roll)
+{
+    (void)rules;
+    return Prime_IsPrime(roll);
+}
+
+uint16 Rules_Points(const rules_t *rules, uint8 roll)
+{
+    return (0u != Rules_IsMaster(rules, roll)) ? rules->masterPoints : rules->normalPoints;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,54 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef RULES_H
+#define RULES_H
+
+#include "cytypes.h"
+
+/*
+ * Scoring rules of the casino game as plain data. Nothing here touches the
+ * hardware, so the same tables are played by the firmware and by the host
+ * simulator in ../sim, which benchmarks the entries of Rules_table side by
+ * side.
+ */
+
+#define RULES_MAX_REROLLS   (4u)
+
+typedef struct
+{
+    const char8 *name;
+    uint16 targetScore;         // game ends once a player reaches this
+    uint16 masterPoints;        // prime roll
+    uint16 normalPoints;        // any other roll
+    uint8 maxRoll;              // knob values above this are rerolled
+    uint8 randomRolls;          // a reroll is random in 1..randomRolls
+    uint8 rerollCount;
+    uint8 rerolls[RULES_MAX_REROLLS];  // further knob values that are rerolled
+} rules_t;
+
+// Rules the board shipped with: +20 on a prime, +7 otherwise, first to 50.
+extern const rules_t Rules_classic;
+
+// Alternatives for the simulator, Rules_table[0] is Rules_classic.
+extern const rules_t * const Rules_table[];
+extern const uint8 Rules_count;
+
+// 1 if the knob value has to be replaced by a random roll.
+uint8 Rules_IsReroll(const rules_t *rules, uint8 knob);
+
+// 1 if the roll is a master move.
+uint8 Rules_IsMaster(const rules_t *rules, uint8 roll);
+
+uint16 Rules_Points(const rules_t *rules, uint8 roll);
+
+#endif /* RULES_H */
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <stddef.h>
+#include "lcd_fb.h"
+#include "lcd_screen.h"
+#include "screens.h"
+
+// Scoreboard cells when there are more players than fit under "Welcome"
+#define BOARD_PER_ROW   ((GAME_PLAYERS + 1u) / 2u)
+#define BOARD_CELL      (LCD_FB_COLS / BOARD_PER_ROW)
+
+#if (GAME_PLAYERS == 1u)
+    static const lcd_screen_t screenWelcome = {{ "    Welcome", "  P%u: %u" }};
+#elif (GAME_PLAYERS == 2u)
+    static const lcd_screen_t screenWelcome = {{ "    Welcome", "  P%u: %u P%u: %u" }};
+#else
+    // the scoreboard is laid out by ShowScoreboard()
+    static const lcd_screen_t screenWelcome = {{ NULL, NULL }};
+#endif /* GAME_PLAYERS */
+
+static const lcd_screen_t screenTurn    = {{ "TURN: P%u", NULL }};
+static const lcd_screen_t screenRoll    = {{ "    %u", NULL }};
+static const lcd_screen_t screenMaster  = {{ "MASTER MOVE: P%u!!", NULL }};
+static const lcd_screen_t screenScore   = {{ "    P%u: %u", NULL }};
+static const lcd_screen_t screenWinner  = {{ NULL, "    Winner: P%u :))" }};
+
+#if (GAME_PLAYERS > 2u)
+    static void ShowScoreboard(const game_t *game)
+    {
+        uint8 i;
+
+        for (i = 0u; i < GAME_PLAYERS; i++)
+        {
+            LcdFb_Position(i / BOARD_PER_ROW, (i % BOARD_PER_ROW) * BOARD_CELL);
+            if (BOARD_CELL > 6u)
+            {
+                LcdFb_PutChar('P');
+            }
+            // "3:27", each cell is cut off by the next one
+            LcdFb_PrintNumber(i + 1u);
+            LcdFb_PrintString((BOARD_CELL > 6u) ? ": " : ":");
+            LcdFb_PrintNumber(game->players[i].score);
+        }
+    }
+#endif /* GAME_PLAYERS > 2u */
+
+uint16 Screens_Show(const game_t *game)
+{
+    const player_t *player = &game->players[game->player];
+
+    switch (game->state)
+    {
+        case GAME_STATE_WELCOME:
+            #if (GAME_PLAYERS == 1u)
+                return LcdScreen_Show(&screenWelcome, 1u, game->players[0].score);
+            #elif (GAME_PLAYERS == 2u)
+                return LcdScreen_Show(&screenWelcome, 1u, game->players[0].score,
+                                      2u, game->players[1].score);
+            #else
+                LcdScreen_Draw(&screenWelcome);
+                ShowScoreboard(game);
+                return LcdFb_Flush();
+            #endif /* GAME_PLAYERS */
+
+        case GAME_STATE_TURN:
+            return LcdScreen_Show(&screenTurn, game->player + 1u);
+
+        case GAME_STATE_ROLL:
+            return LcdScreen_Show(&screenRoll, player->lastRoll);
+
+        case GAME_STATE_MASTER:
+            return LcdScreen_Show(&screenMaster, game->player + 1u);
+
+        case GAME_STATE_SCORE:
+            return LcdScreen_Show(&screenScore, game->player + 1u, player->score);
+
+        case GAME_STATE_WINNER:
+            return LcdScreen_Show(&screenWinner, game->winner + 1u);
+
+        default:
+            return 0u;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,29 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include "cytypes.h"
+#include "game.h"
+
+/*
+ * The casino's LCD screens, one lcd_screen_t template per game_state_t.
+ * Kept apart from main.c so the host benchmark draws exactly what the
+ * board does.
+ */
+
+// Draws the screen of the game's current state and flushes it, returns
+// the bytes written to the LCD. States without a screen keep the old one.
+uint16 Screens_Show(const game_t *game);
+
+#endif /* SCREENS_H */
+/* [] END OF FILE */
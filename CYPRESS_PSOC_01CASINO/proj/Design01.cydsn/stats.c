@@ -0,0 +1,184 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "stats.h"
+
+static const stats_nv_t *statsNv = NULL;
+static stats_t stats;
+static stats_t statsStored;         // what the store holds, to find changed chunks
+static uint8 statsDirty = 0u;       // RAM is ahead of the store
+static uint8 statsPending = 0u;     // games recorded since the last commit attempt
+static uint32 statsDirtyMs = 0u;    // time the store fell behind
+
+static void Stats_Reset(stats_t *record)
+{
+    (void)memset(record, 0, sizeof(stats_t));
+    record->magic = STATS_MAGIC;
+}
+
+static void Stats_AddScore(uint16 score, uint8 player)
+{
+    uint8 i = STATS_TOP_N;
+
+    if (score <= stats.top[STATS_TOP_N - 1u].score)
+    {
+        return;
+    }
+
+    // insertion from the bottom, equal scores keep the older entry first
+    while ((i > 0u) && (score > stats.top[i - 1u].score))
+    {
+        if (i < STATS_TOP_N)
+        {
+            stats.top[i] = stats.top[i - 1u];
+        }
+        i--;
+    }
+    stats.top[i].score = score;
+    stats.top[i].player = player;
+    stats.top[i].reserved = 0u;
+}
+
+void Stats_Init(const stats_nv_t *nv)
+{
+    statsNv = nv;
+    statsDirty = 0u;
+    statsPending = 0u;
+
+    if ((NULL == nv) || (0u != nv->read(0u, &statsStored, sizeof(stats_t))) ||
+        (STATS_MAGIC != statsStored.magic))
+    {
+        // a blank store or another layout: start over, written with the first game
+        Stats_Reset(&stats);
+        (void)memset(&statsStored, 0xFF, sizeof(stats_t));
+    }
+    else
+    {
+        stats = statsStored;
+    }
+}
+
+void Stats_RecordGame(const game_t *game)
+{
+    uint8 winner = game->winner;
+    uint8 i;
+
+    stats.gamesPlayed++;
+    stats.wins[winner]++;
+
+    if ((0u != stats.streak) && (stats.streakPlayer == winner))
+    {
+        stats.streak++;
+    }
+    else
+    {
+        stats.streakPlayer = winner;
+        stats.streak = 1u;
+    }
+    if (stats.streak > stats.longestStreak)
+    {
+        stats.longestStreak = stats.streak;
+        stats.longestStreakPlayer = winner;
+    }
+
+    for (i = 0u; i < GAME_PLAYERS; i++)
+    {
+        Stats_AddScore(game->players[i].score, i);
+    }
+
+    if (0u == statsDirty)
+    {
+        statsDirty = 1u;
+        statsDirtyMs = game->enteredMs;
+    }
+    if (statsPending < 0xFFu)
+    {
+        statsPending++;
+    }
+}
+
+void Stats_Service(uint32 nowMs)
+{
+    if (0u == statsDirty)
+    {
+        return;
+    }
+
+    if ((statsPending >= STATS_GAMES_PER_COMMIT) ||
+        ((uint32)(nowMs - statsDirtyMs) >= STATS_DIRTY_TIMEOUT_MS))
+    {
+        if (0u != Stats_Commit())
+        {
+            // keep the batch and retry after another timeout
+            statsPending = 0u;
+            statsDirtyMs = nowMs;
+        }
+    }
+}
+
+uint8 Stats_Commit(void)
+{
+    const uint8 *ram = (const uint8 *)&stats;
+    uint8 *stored = (uint8 *)&statsStored;
+    uint32 offset;
+    uint32 size;
+    uint8 result = 0u;
+
+    if (NULL == statsNv)
+    {
+        statsStored = stats;
+        statsDirty = 0u;
+        statsPending = 0u;
+        return 0u;
+    }
+
+    // one row write per changed chunk, unchanged chunks cost no erase cycle
+    for (offset = 0u; offset < sizeof(stats_t); offset += STATS_NV_CHUNK)
+    {
+        size = sizeof(stats_t) - offset;
+        if (size > STATS_NV_CHUNK)
+        {
+            size = STATS_NV_CHUNK;
+        }
+
+        if (0 != memcmp(&ram[offset], &stored[offset], size))
+        {
+            if (0u == statsNv->write(offset, &ram[offset], size))
+            {
+                (void)memcpy(&stored[offset], &ram[offset], size);
+            }
+            else
+            {
+                result = 1u;
+            }
+        }
+    }
+
+    if (0u == result)
+    {
+        statsDirty = 0u;
+        statsPending = 0u;
+    }
+    return result;
+}
+
+uint8 Stats_IsDirty(void)
+{
+    return statsDirty;
+}
+
+const stats_t *Stats_Get(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
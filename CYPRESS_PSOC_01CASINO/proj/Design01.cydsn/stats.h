@@ -0,0 +1,98 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef STATS_H
+#define STATS_H
+
+#include "cytypes.h"
+#include "game.h"
+
+/*
+ * Lifetime statistics of the board: games played, wins per player, the
+ * best scores and the longest run of wins by one player. Everything is
+ * kept and read in RAM; the non-volatile copy is only written by
+ * Stats_Service(), in row-sized chunks and only for the chunks that
+ * changed. The store itself plugs in through stats_nv_t, the firmware uses
+ * Em_EEPROM (stats_eeprom.c) and the host test a simulated flash.
+ */
+
+#ifndef STATS_TOP_N
+    #define STATS_TOP_N             (5u)
+#endif /* STATS_TOP_N */
+
+// Finished games collected in RAM before a commit is due. A power cut loses
+// at most the games of an uncommitted batch; with 8 the most worn row sees
+// about 300 erases per 10,000 games instead of 2500 with a commit per game.
+#ifndef STATS_GAMES_PER_COMMIT
+    #define STATS_GAMES_PER_COMMIT  (8u)
+#endif /* STATS_GAMES_PER_COMMIT */
+
+// A partial batch is committed once it has been dirty this long
+#ifndef STATS_DIRTY_TIMEOUT_MS
+    #define STATS_DIRTY_TIMEOUT_MS  (600000u)
+#endif /* STATS_DIRTY_TIMEOUT_MS */
+
+// Bytes one Em_EEPROM row write carries, CY_EM_EEPROM_HEADER_DATA_LEN
+#define STATS_NV_CHUNK              (112u)
+
+// Changes whenever stats_t changes layout, older records are discarded
+#define STATS_MAGIC                 (0x53540100u | GAME_PLAYERS)
+
+typedef struct
+{
+    uint16 score;
+    uint8 player;
+    uint8 reserved;
+} stats_score_t;
+
+typedef struct
+{
+    uint32 magic;
+    uint32 gamesPlayed;
+    uint32 wins[GAME_PLAYERS];
+    stats_score_t top[STATS_TOP_N];     // best first, score 0 is unused
+    uint16 streak;                      // current run of wins by streakPlayer
+    uint16 longestStreak;
+    uint8 streakPlayer;
+    uint8 longestStreakPlayer;
+    uint16 reserved;
+} stats_t;
+
+typedef struct
+{
+    // Both return 0 on success
+    uint8 (*read)(uint32 offset, void *dst, uint32 size);
+    uint8 (*write)(uint32 offset, const void *src, uint32 size);
+} stats_nv_t;
+
+// Loads the record from the store, or starts from zero if there is none
+// or it cannot be read. A NULL store keeps the statistics in RAM only.
+void Stats_Init(const stats_nv_t *nv);
+
+// Adds a finished game, call once in GAME_STATE_WINNER.
+void Stats_RecordGame(const game_t *game);
+
+// Writes the changed chunks once a batch is full or the dirty timeout has
+// passed. It may block for a flash write per chunk, so only call it where
+// that cannot stall a turn, e.g. on the winner screen.
+void Stats_Service(uint32 nowMs);
+
+// Writes the changed chunks now, returns 0 on success.
+uint8 Stats_Commit(void);
+
+// 1 while RAM holds changes that are not in the store yet.
+uint8 Stats_IsDirty(void);
+
+// RAM copy, never touches the store
+const stats_t *Stats_Get(void);
+
+#endif /* STATS_H */
+/* [] END OF FILE */
@@ -0,0 +1,61 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include "project.h"
+#include "stats_eeprom.h"
+
+#if (STATS_NV_CHUNK != CY_EM_EEPROM_HEADER_DATA_LEN)
+    #error "STATS_NV_CHUNK must match the Em_EEPROM row payload"
+#endif
+
+#define STATS_EEPROM_FLASH_SIZE     CY_EM_EEPROM_GET_PHYSICAL_SIZE(sizeof(stats_t), \
+                                        STATS_EEPROM_WEAR_LEVELING, STATS_EEPROM_REDUNDANT_COPY)
+
+// Em_EEPROM takes an all-zero area as blank, so it ships zeroed in the image
+static const uint8 CY_ALIGN(CY_FLASH_SIZEOF_ROW) statsFlash[STATS_EEPROM_FLASH_SIZE] = { 0u };
+
+static cy_stc_eeprom_context_t statsEeprom;
+
+static uint8 StatsEeprom_Read(uint32 offset, void *dst, uint32 size)
+{
+    return (CY_EM_EEPROM_SUCCESS == Cy_Em_EEPROM_Read(offset, dst, size, &statsEeprom)) ? 0u : 1u;
+}
+
+static uint8 StatsEeprom_Write(uint32 offset, const void *src, uint32 size)
+{
+    // Em_EEPROM does not modify the source, its prototype just lacks const
+    return (CY_EM_EEPROM_SUCCESS == Cy_Em_EEPROM_Write(offset, (void *)src, size, &statsEeprom)) ? 0u : 1u;
+}
+
+static const stats_nv_t statsEepromNv =
+{
+    &StatsEeprom_Read,
+    &StatsEeprom_Write
+};
+
+const stats_nv_t *StatsEeprom_Start(void)
+{
+    cy_stc_eeprom_config_t config;
+
+    config.eepromSize = sizeof(stats_t);
+    config.wearLevelingFactor = STATS_EEPROM_WEAR_LEVELING;
+    config.redundantCopy = STATS_EEPROM_REDUNDANT_COPY;
+    config.blockingWrite = 1u;
+    config.userFlashStartAddr = (uint32)statsFlash;
+
+    if (CY_EM_EEPROM_SUCCESS != Cy_Em_EEPROM_Init(&config, &statsEeprom))
+    {
+        return NULL;
+    }
+    return &statsEepromNv;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,37 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef STATS_EEPROM_H
+#define STATS_EEPROM_H
+
+#include "cytypes.h"
+#include "stats.h"
+
+/*
+ * stats_nv_t on top of the Em_EEPROM middleware. The record lives in a
+ * row-aligned const array in flash that rotates through
+ * STATS_EEPROM_WEAR_LEVELING copies, optionally mirrored by a redundant
+ * copy that Em_EEPROM falls back to if a row checksum is bad.
+ */
+
+#ifndef STATS_EEPROM_WEAR_LEVELING
+    #define STATS_EEPROM_WEAR_LEVELING  (4u)    // 1..10
+#endif /* STATS_EEPROM_WEAR_LEVELING */
+
+#ifndef STATS_EEPROM_REDUNDANT_COPY
+    #define STATS_EEPROM_REDUNDANT_COPY (1u)
+#endif /* STATS_EEPROM_REDUNDANT_COPY */
+
+// Returns the store for Stats_Init(), or NULL if Em_EEPROM cannot start.
+const stats_nv_t *StatsEeprom_Start(void);
+
+#endif /* STATS_EEPROM_H */
+/* [] END OF FILE */
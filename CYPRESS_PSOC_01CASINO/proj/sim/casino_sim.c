@@ -0,0 +1,357 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host Monte Carlo simulator for the casino game. It plays the firmware's
+ * own game.c state machine with every rule set in Rules_table, one thread
+ * per core, and reports who wins, how long games last and how the knob's
+ * ADC-to-percent mapping skews the rolls.
+ *
+ * Build and run from this directory (cytypes.h here replaces the generated
+ * one):
+ *
+ *   gcc -O2 -pthread -I. -I../Design01.cydsn -DRNG_HARDWARE_SEED=0 \
+ *       -DADC_SCALE_RESOLUTION=8 -DADC_SCALE_FULL_MV=5000 \
+ *       casino_sim.c ../Design01.cydsn/game.c ../Design01.cydsn/rules.c \
+ *       ../Design01.cydsn/prime.c ../Design01.cydsn/rng.c \
+ *       ../Design01.cydsn/adc_scale.c -o casino_sim
+ *   ./casino_sim [games per rule set] [threads] [seed]
+ *
+ * Add -DGAME_PLAYERS=n to simulate another table size.
+ *
+ * The knob is modelled as a player who turns it anywhere, i.e. a uniform
+ * 8-bit ADC count.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cytypes.h"
+#include "adc_scale.h"
+#include "game.h"
+#include "prime.h"
+#include "rng.h"
+#include "rules.h"
+
+#define SIM_DEFAULT_GAMES   (10000000ul)
+#define SIM_MAX_THREADS     (256u)
+#define SIM_MAX_TURNS       (255u)      // longer games land in the last bucket
+#define SIM_ADC_CODES       (ADC_SCALE_MAX_COUNT + 1u)
+
+typedef struct
+{
+    uint64 games;
+    uint64 wins[GAME_PLAYERS];
+    uint64 ties;                        // winner only by the tie rule
+    uint64 turns;
+    uint64 masters;
+    uint64 rerolls;
+    uint64 gameMs;
+    uint64 turnHist[SIM_MAX_TURNS + 1u];
+} sim_stats_t;
+
+typedef struct
+{
+    pthread_t thread;
+    const rules_t *rules;
+    uint64 games;
+    uint64 seed;
+    uint64 stream;
+    sim_stats_t stats;
+} sim_worker_t;
+
+// game_io_t callbacks have no context argument, so each thread keeps its own
+static __thread rng_t simRng;
+static __thread sim_stats_t *simStats;
+static __thread uint8 simDone;
+static __thread uint32 simEndMs;
+
+static uint8 Sim_ReadKnob(void)
+{
+    return AdcScale_ToPercent((uint16)Rng_Bounded(&simRng, SIM_ADC_CODES));
+}
+
+static uint8 Sim_Random(uint8 range)
+{
+    simStats->rerolls++;
+    return (uint8)Rng_Bounded(&simRng, range);
+}
+
+static void Sim_Enter(const game_t *game)
+{
+    uint8 i;
+
+    switch (game->state)
+    {
+        case GAME_STATE_ROLL:
+            simStats->turns++;
+            break;
+
+        case GAME_STATE_MASTER:
+            simStats->masters++;
+            break;
+
+        case GAME_STATE_WINNER:
+            simStats->wins[game->winner]++;
+            for (i = 0u; i < GAME_PLAYERS; i++)
+            {
+                if ((i != game->winner) && (game->players[i].score == game->players[game->winner].score))
+                {
+                    simStats->ties++;
+                    break;
+                }
+            }
+            simEndMs = game->enteredMs;
+            simDone = 1u;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static const game_io_t simIo =
+{
+    &Sim_ReadKnob,
+    &Sim_Random,
+    &Sim_Enter
+};
+
+static void *Sim_Worker(void *arg)
+{
+    sim_worker_t *worker = arg;
+    game_t game;
+    uint64 n;
+    uint64 turnsBefore;
+    uint64 turns;
+
+    Rng_Seed(&simRng, worker->seed, worker->stream);
+    simStats = &worker->stats;
+
+    for (n = 0u; n < worker->games; n++)
+    {
+        turnsBefore = simStats->turns;
+        simDone = 0u;
+        Game_Init(&game, &simIo, worker->rules, 0u);
+        while (0u == simDone)
+        {
+            Game_Run(&game, Game_NextDeadline(&game));
+        }
+
+        turns = simStats->turns - turnsBefore;
+        simStats->turnHist[(turns < SIM_MAX_TURNS) ? turns : SIM_MAX_TURNS]++;
+        simStats->gameMs += simEndMs;
+        simStats->games++;
+    }
+
+    return NULL;
+}
+
+static double Sim_Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static uint32 Sim_Percentile(const sim_stats_t *stats, double fraction)
+{
+    uint64 limit = (uint64)((double)stats->games * fraction);
+    uint64 seen = 0u;
+    uint32 turns;
+
+    for (turns = 0u; turns < SIM_MAX_TURNS; turns++)
+    {
+        seen += stats->turnHist[turns];
+        if (seen > limit)
+        {
+            break;
+        }
+    }
+
+    return turns;
+}
+
+static void Sim_RunRules(const rules_t *rules, uint8 index, uint64 games, uint32 threads, uint64 seed)
+{
+    static sim_worker_t workers[SIM_MAX_THREADS];
+    sim_stats_t total = { 0u };
+    double start;
+    double seconds;
+    uint32 t;
+    uint32 i;
+
+    start = Sim_Now();
+    for (t = 0u; t < threads; t++)
+    {
+        sim_worker_t *worker = &workers[t];
+
+        worker->rules = rules;
+        worker->games = (games / threads) + ((t < (games % threads)) ? 1u : 0u);
+        worker->seed = seed;
+        worker->stream = ((uint64)index << 32u) | t;
+        worker->stats = total;
+        (void)pthread_create(&worker->thread, NULL, &Sim_Worker, worker);
+    }
+
+    for (t = 0u; t < threads; t++)
+    {
+        const sim_stats_t *stats = &workers[t].stats;
+
+        (void)pthread_join(workers[t].thread, NULL);
+        total.games += stats->games;
+        total.ties += stats->ties;
+        total.turns += stats->turns;
+        total.masters += stats->masters;
+        total.rerolls += stats->rerolls;
+        total.gameMs += stats->gameMs;
+        for (i = 0u; i < GAME_PLAYERS; i++)
+        {
+            total.wins[i] += stats->wins[i];
+        }
+        for (i = 0u; i <= SIM_MAX_TURNS; i++)
+        {
+            total.turnHist[i] += stats->turnHist[i];
+        }
+    }
+    seconds = Sim_Now() - start;
+
+    printf("%-12s %6.2f", rules->name, ((double)total.games / seconds) * 1e-6);
+    for (i = 0u; i < GAME_PLAYERS; i++)
+    {
+        printf(" %6.2f", (100.0 * (double)total.wins[i]) / (double)total.games);
+    }
+    printf(" %6.2f %6.2f %5u %5u %6.1f %7.2f %6.2f\n",
+        (100.0 * (double)total.ties) / (double)total.games,
+        (double)total.turns / (double)total.games,
+        Sim_Percentile(&total, 0.5), Sim_Percentile(&total, 0.99),
+        ((double)total.gameMs / (double)total.games) * 1e-3,
+        (100.0 * (double)total.masters) / (double)total.turns,
+        (100.0 * (double)total.rerolls) / (double)total.turns);
+}
+
+/*
+ * Exact roll odds for a uniform ADC count: how many codes land on each
+ * percent and how far the master rate is from a fair 1..99 dial.
+ */
+static void Sim_ReportMapping(const rules_t *rules)
+{
+    uint16 codes[256] = { 0u };
+    double master = 0.0;
+    double reroll = 0.0;
+    double fairMaster = 0.0;
+    double randomMaster = 0.0;
+    uint16 fewest = 0xFFFFu;
+    uint16 most = 0u;
+    uint16 code;
+    uint16 value;
+    uint16 played = 0u;
+
+    for (value = 1u; value <= rules->randomRolls; value++)
+    {
+        randomMaster += (double)Rules_IsMaster(rules, (uint8)value);
+    }
+    randomMaster /= (double)rules->randomRolls;
+
+    for (code = 0u; code < SIM_ADC_CODES; code++)
+    {
+        uint8 knob = AdcScale_ToPercent(code);
+
+        codes[knob]++;
+        if (0u != Rules_IsReroll(rules, knob))
+        {
+            reroll += 1.0;
+            master += randomMaster;
+        }
+        else
+        {
+            master += (double)Rules_IsMaster(rules, knob);
+        }
+    }
+
+    for (value = 0u; value <= 100u; value++)
+    {
+        if (0u == Rules_IsReroll(rules, (uint8)value))
+        {
+            fairMaster += (double)Rules_IsMaster(rules, (uint8)value);
+            played++;
+            if (codes[value] < fewest)
+            {
+                fewest = codes[value];
+            }
+            if (codes[value] > most)
+            {
+                most = codes[value];
+            }
+        }
+    }
+    fairMaster /= (double)played;
+
+    printf("knob mapping (%s): %u ADC codes onto 0..100, %u-%u codes per playable value\n",
+        rules->name, SIM_ADC_CODES, fewest, most);
+    printf("  reroll %.2f%%, master %.3f%% per turn vs %.3f%% for an even dial (bias %+.3f%%)\n\n",
+        (100.0 * reroll) / SIM_ADC_CODES, (100.0 * master) / SIM_ADC_CODES,
+        100.0 * fairMaster, (100.0 * master) / SIM_ADC_CODES - 100.0 * fairMaster);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64 games = SIM_DEFAULT_GAMES;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32 threads = (cores > 0) ? (uint32)cores : 1u;
+    uint64 seed = 1u;
+    uint8 i;
+
+    if (argc > 1)
+    {
+        games = strtoull(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        threads = (uint32)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3)
+    {
+        seed = strtoull(argv[3], NULL, 0);
+    }
+    if ((0u == threads) || (threads > SIM_MAX_THREADS))
+    {
+        threads = SIM_MAX_THREADS;
+    }
+
+    printf("%llu games per rule set on %u threads, seed %llu\n\n",
+        (unsigned long long)games, threads, (unsigned long long)seed);
+
+    for (i = 0u; i < Rules_count; i++)
+    {
+        Sim_ReportMapping(Rules_table[i]);
+    }
+
+    printf("%-12s %6s", "rules", "Mgame/s");
+    for (i = 0u; i < GAME_PLAYERS; i++)
+    {
+        printf("   P%u %%", i + 1u);
+    }
+    printf(" %6s %6s %5s %5s %6s %7s %6s\n", "tie %", "turns", "p50", "p99", "secs", "master%", "rerol%");
+    for (i = 0u; i < Rules_count; i++)
+    {
+        Sim_RunRules(Rules_table[i], i, games, threads, seed);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,313 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host replay of the casino state machine on a virtual clock. The same
+ * scripted games (knob positions and rerolls) are played through game.c
+ * with Game_Run() called in different ways:
+ *
+ *  - only at each state's deadline, as an idle loop woken by a timer would
+ *  - on every 1 ms tick, as main.c does with tick.c
+ *  - on a coarse 7 ms and 250 ms tick
+ *  - on a 1 ms tick with one 20 s stall in the middle of a game
+ *
+ * Every run has to produce the same states at the same times: each state
+ * starts exactly where the one before it ended, however late Game_Run()
+ * gets to it. The clock starts just before the uint32 millisecond counter
+ * wraps. The first game is printed as a timeline, and the host cost of a
+ * Game_Run() call is timed for every run.
+ *
+ *   gcc -O2 -Wall -Wextra -I. -I../Design01.cydsn \
+ *       game_replay.c ../Design01.cydsn/game.c ../Design01.cydsn/rules.c \
+ *       ../Design01.cydsn/prime.c -o game_replay
+ *   ./game_replay [games]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cytypes.h"
+#include "game.h"
+#include "rules.h"
+
+#define SIM_DEFAULT_GAMES   (3u)
+#define SIM_MAX_ENTRIES     (4096u)
+#define SIM_START_MS        (0xFFFF0000u)   // wraps after 65.5 s
+#define SIM_STALL_AT_MS     (30000uL)       // from the start
+#define SIM_STALL_MS        (20000uL)
+
+typedef enum
+{
+    SIM_DEADLINE = 0,
+    SIM_TICK,
+    SIM_STALL
+} sim_mode_t;
+
+typedef struct
+{
+    uint32 enteredMs;
+    uint8 state;
+    uint8 player;
+    uint8 roll;
+    uint8 flags;
+    uint16 score;
+} sim_entry_t;
+
+typedef struct
+{
+    const char *name;
+    sim_mode_t mode;
+    uint32 stepMs;
+} sim_run_t;
+
+static const sim_run_t simRuns[] =
+{
+    { "at each deadline",       SIM_DEADLINE,   0u },
+    { "1 ms tick",              SIM_TICK,       1u },
+    { "7 ms tick",              SIM_TICK,       7u },
+    { "250 ms tick",            SIM_TICK,       250u },
+    { "1 ms tick, 20 s stall",  SIM_STALL,      1u },
+};
+
+#define SIM_RUNS    (sizeof(simRuns) / sizeof(simRuns[0]))
+
+// knob positions in percent, 0, 96 and 100 are rerolled by the classic rules
+static const uint8 simKnob[] = { 37u, 2u, 96u, 50u, 0u, 100u, 11u, 64u, 3u, 88u, 61u };
+static const uint8 simRandom[] = { 4u, 18u, 72u, 45u, 60u };
+
+static const char *const simStateNames[GAME_STATE_COUNT] =
+{
+    "WELCOME", "TURN", "ROLL", "MASTER", "SCORE", "REST", "WINNER"
+};
+
+static uint32 simNowMs;
+static uint32 simKnobIndex;
+static uint32 simRandomIndex;
+static uint32 simWinners;
+static uint32 simMaxLagMs;
+
+static sim_entry_t simTrace[SIM_RUNS][SIM_MAX_ENTRIES];
+static uint32 simCount[SIM_RUNS];
+static sim_entry_t *simRecord;
+static uint32 *simRecordCount;
+
+static uint8 Sim_ReadKnob(void)
+{
+    return simKnob[simKnobIndex++ % (sizeof(simKnob) / sizeof(simKnob[0]))];
+}
+
+static uint8 Sim_Random(uint8 range)
+{
+    return (uint8)(simRandom[simRandomIndex++ % (sizeof(simRandom) / sizeof(simRandom[0]))] % range);
+}
+
+static void Sim_Enter(const game_t *game)
+{
+    const player_t *player = &game->players[game->player];
+    sim_entry_t *entry;
+
+    // the board draws the screen when Game_Run() gets to it
+    if ((uint32)(simNowMs - game->enteredMs) > simMaxLagMs)
+    {
+        simMaxLagMs = simNowMs - game->enteredMs;
+    }
+    if (GAME_STATE_WINNER == game->state)
+    {
+        simWinners++;
+    }
+    if (*simRecordCount < SIM_MAX_ENTRIES)
+    {
+        entry = &simRecord[(*simRecordCount)++];
+        entry->enteredMs = game->enteredMs;
+        entry->state = (uint8)game->state;
+        entry->player = game->player;
+        entry->roll = player->lastRoll;
+        entry->flags = player->flags;
+        entry->score = player->score;
+    }
+}
+
+static const game_io_t simIo =
+{
+    Sim_ReadKnob,
+    Sim_Random,
+    Sim_Enter
+};
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-44s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+// Plays the scripted games, returns the host time of all Game_Run() calls.
+static double Sim_Play(uint32 run, uint32 games, uint32 *calls)
+{
+    const sim_run_t *how = &simRuns[run];
+    struct timespec t0;
+    struct timespec t1;
+    game_t game;
+    double ns = 0.0;
+    uint8 stalled = 0u;
+
+    simKnobIndex = 0u;
+    simRandomIndex = 0u;
+    simWinners = 0u;
+    simMaxLagMs = 0u;
+    simRecord = simTrace[run];
+    simRecordCount = &simCount[run];
+    *calls = 0u;
+
+    simNowMs = SIM_START_MS;
+    Game_Init(&game, &simIo, &Rules_classic, simNowMs);
+    while (simWinners < games)
+    {
+        if (SIM_DEADLINE == how->mode)
+        {
+            simNowMs = Game_NextDeadline(&game);
+        }
+        else if ((SIM_STALL == how->mode) && (0u == stalled) &&
+                 ((uint32)(simNowMs - SIM_START_MS) >= SIM_STALL_AT_MS))
+        {
+            simNowMs += SIM_STALL_MS;
+            stalled = 1u;
+        }
+        else
+        {
+            simNowMs += how->stepMs;
+        }
+
+        (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+        Game_Run(&game, simNowMs);
+        (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns += (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+        (*calls)++;
+    }
+
+    return ns;
+}
+
+static void Sim_PrintFirstGame(const sim_entry_t *trace, uint32 count)
+{
+    uint32 i;
+
+    printf("first game, time from the start:\n");
+    printf("  %8s  %-8s %-3s %5s %6s\n", "ms", "state", "P", "roll", "score");
+    for (i = 0u; i < count; i++)
+    {
+        printf("  %8u  %-8s P%-2u", (uint32)(trace[i].enteredMs - SIM_START_MS),
+            simStateNames[trace[i].state], trace[i].player + 1u);
+        if ((GAME_STATE_WELCOME == trace[i].state) || (GAME_STATE_TURN == trace[i].state))
+        {
+            printf(" %5s %6u\n", "", trace[i].score);
+        }
+        else
+        {
+            printf(" %5u %6u%s%s\n", trace[i].roll, trace[i].score,
+                (0u != (trace[i].flags & GAME_FLAG_REROLLED)) ? "  rerolled" : "",
+                (0u != (trace[i].flags & GAME_FLAG_MASTER)) ? "  master" : "");
+        }
+        if (GAME_STATE_WINNER == trace[i].state)
+        {
+            break;
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 games = SIM_DEFAULT_GAMES;
+    uint32 run;
+    uint32 i;
+    uint32 calls;
+    uint32 lag[SIM_RUNS];
+    uint32 firstGameMs = 0u;
+    uint32 count;
+    uint8 failed = 0u;
+    uint8 same = 1u;
+    uint8 chained = 1u;
+    uint8 prompt = 1u;
+    double ns[SIM_RUNS];
+    uint32 callCount[SIM_RUNS];
+
+    if (argc > 1)
+    {
+        games = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (0u == games)
+    {
+        games = 1u;
+    }
+
+    for (run = 0u; run < SIM_RUNS; run++)
+    {
+        ns[run] = Sim_Play(run, games, &calls);
+        callCount[run] = calls;
+        lag[run] = simMaxLagMs;
+    }
+
+    // the runs that overshoot record more, compare what all of them have
+    count = simCount[0];
+    for (run = 1u; run < SIM_RUNS; run++)
+    {
+        if (simCount[run] < count)
+        {
+            count = simCount[run];
+        }
+    }
+    for (run = 1u; run < SIM_RUNS; run++)
+    {
+        same &= (0 == memcmp(simTrace[0], simTrace[run], count * sizeof(sim_entry_t))) ? 1u : 0u;
+    }
+    for (i = 1u; i < count; i++)
+    {
+        const sim_entry_t *prev = &simTrace[0][i - 1u];
+
+        chained &= (simTrace[0][i].enteredMs ==
+                    (uint32)(prev->enteredMs + Game_DwellMs((game_state_t)prev->state))) ? 1u : 0u;
+        if ((GAME_STATE_WINNER == prev->state) && (0u == firstGameMs))
+        {
+            firstGameMs = (uint32)(simTrace[0][i].enteredMs - SIM_START_MS);
+        }
+    }
+    for (run = 1u; run < SIM_RUNS; run++)
+    {
+        if (SIM_TICK == simRuns[run].mode)
+        {
+            prompt &= (lag[run] < simRuns[run].stepMs) ? 1u : 0u;
+        }
+    }
+
+    Sim_PrintFirstGame(simTrace[0], count);
+    printf("%u games, %u states, %.1f s of game time, the clock wraps after 65.5 s\n",
+        games, count, (double)(uint32)(simTrace[0][count - 1u].enteredMs - SIM_START_MS) / 1000.0);
+    printf("first game over after %.1f s\n\n", (double)firstGameMs / 1000.0);
+    printf("  %-24s %10s %12s %14s\n", "Game_Run() called", "calls", "worst lag", "host ns/call");
+    for (run = 0u; run < SIM_RUNS; run++)
+    {
+        printf("  %-24s %10u %9u ms %14.1f\n", simRuns[run].name, callCount[run], lag[run],
+            ns[run] / (double)callCount[run]);
+    }
+    printf("\n");
+
+    failed |= Sim_Check(same, "every run plays the same states and times");
+    failed |= Sim_Check(chained, "each state starts where the last one ended");
+    failed |= Sim_Check(prompt, "a tick shows each state within one period");
+    failed |= Sim_Check(count > 2u, "games were played");
+
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
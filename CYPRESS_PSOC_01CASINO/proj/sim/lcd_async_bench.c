@@ -0,0 +1,333 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host model of the CPU time an LCD update costs with the blocking and the
+ * queued lcd_async.c. Build it once per LCD_ASYNC_ENABLE and compare:
+ *
+ *   gcc -O2 -Wall -Wextra -I. -I../Design01.cydsn -DLCD_FB_MEASURE_CYCLES=1 \
+ *       -DLCD_ASYNC_ENABLE=0 lcd_async_bench.c ../Design01.cydsn/lcd_fb.c \
+ *       ../Design01.cydsn/lcd_async.c -o lcd_blocking
+ *   gcc ... -DLCD_ASYNC_ENABLE=1 ... -o lcd_queued
+ *   ./lcd_blocking; ./lcd_queued
+ *
+ * The screens are drawn with the firmware's lcd_fb.c, and each flush is
+ * timed by LcdFb_LastFlushCycles() just as on the board. DWT->CYCCNT is
+ * the model's clock and only the hardware calls advance it; the cell diff
+ * inside LcdFb_Flush() is the same in both builds and is not counted.
+ *
+ *  - blocking: LCD_WriteControl()/LCD_WriteData() as in LCD.c, which
+ *    polls the busy flag (two E pulses, then CyDelayUs(10) while busy)
+ *    before writing two nibbles
+ *  - queued: each byte costs LcdAsync_Put(), charged where it enters its
+ *    critical section. The LCD_Timer interrupt then runs every
+ *    LCD_ASYNC_TICK_US from the real LcdAsync_Isr, and its cycles are
+ *    counted apart from the flush.
+ *
+ * The per-operation cycle costs below are estimates for the Cortex-M3 at
+ * BCLK__BUS_CLK__HZ, not measurements. An HD44780 model decodes the nibbles,
+ * keeps the DDRAM and checks that no byte arrives while the controller is
+ * still busy (37 us per byte, 1.52 ms for clear and home).
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "lcd_async.h"
+#include "lcd_fb.h"
+
+#define SIM_MHZ                 (BCLK__BUS_CLK__HZ / 1000000u)
+#define SIM_DDRAM               (0x80u)
+#define SIM_ROW_1               (0x40u)
+#define SIM_EXEC_US             (37u)
+#define SIM_SLOW_EXEC_US        (1520u)
+#define SIM_ROUNDS              (10u)
+
+// blocking LCD.c, per LCD_WriteControl()/LCD_WriteData()
+#define SIM_READY_SETUP_CYCLES  (60u)   // data pins to High-Z and back
+#define SIM_READY_POLL_CYCLES   (100u)  // one busy read, 2 x CyDelayUs(1)
+#define SIM_READY_WAIT_US       (10u)   // CyDelayUs(10) while busy
+#define SIM_NIBBLE_CYCLES       (50u)   // port writes and CyDelayUs(1)
+
+// queued lcd_async.c
+#define SIM_PUT_CYCLES          (40u)   // LcdAsync_Put()
+#define SIM_ISR_CYCLES          (50u)   // entry, exit, status read, branches
+
+typedef struct
+{
+    const char *name;
+    const char *rows[LCD_FB_ROWS];
+} sim_screen_t;
+
+static const sim_screen_t simScreens[] =
+{
+    { "full screen A",  { "0123456789ABCDEF", "FEDCBA9876543210" } },
+    { "full screen B",  { "abcdefghijklmnop", "ponmlkjihgfedcba" } },
+    { "welcome",        { "    Welcome", "  P1: 27 P2: 7" } },
+    { "turn",           { "TURN: P1", NULL } },
+    { "roll",           { "    37", NULL } },
+    { "score",          { "    P1: 47", NULL } },
+};
+
+#define SIM_SCREENS (sizeof(simScreens) / sizeof(simScreens[0]))
+
+DWT_Type simDwt;
+CoreDebug_Type simCoreDebug;
+uint8 simLcdPort;
+
+static char8 simDdram[SIM_DDRAM];
+static uint8 simAddr = 0u;
+static uint32 simBusyUntil = 0u;
+static uint32 simEarly = 0u;            // bytes sent while the controller was busy
+static uint32 simBytes = 0u;
+static uint32 simNibbles = 0u;
+static uint8 simHigh = 0u;
+static uint8 simHaveHigh = 0u;
+
+static cyisraddress simIsr = NULL;
+static uint8 simTimerOn = 0u;
+
+static uint8 Sim_Busy(void)
+{
+    return ((int32)(simBusyUntil - simDwt.CYCCNT) > 0) ? 1u : 0u;
+}
+
+// HD44780: a whole byte has arrived
+static void Sim_LcdByte(uint8 data, uint8 value)
+{
+    uint32 execUs = SIM_EXEC_US;
+
+    simBytes++;
+    if (0u != data)
+    {
+        simDdram[simAddr] = (char8)value;
+        simAddr = (simAddr + 1u) & 0x7Fu;
+    }
+    else if (0u != (value & 0x80u))
+    {
+        simAddr = value & 0x7Fu;
+    }
+    else if ((0u != value) && (value <= LCD_RESET_CURSOR_POSITION))
+    {
+        if (LCD_CLEAR_DISPLAY == value)
+        {
+            (void)memset(simDdram, ' ', sizeof(simDdram));
+        }
+        simAddr = 0u;
+        execUs = SIM_SLOW_EXEC_US;
+    }
+    simBusyUntil = simDwt.CYCCNT + (execUs * SIM_MHZ);
+}
+
+// LCD.c: LCD_IsReady(), then two nibbles
+static void Sim_Blocking(uint8 data, uint8 value)
+{
+    simDwt.CYCCNT += SIM_READY_SETUP_CYCLES;
+    for (;;)
+    {
+        simDwt.CYCCNT += SIM_READY_POLL_CYCLES;
+        if (0u == Sim_Busy())
+        {
+            break;
+        }
+        simDwt.CYCCNT += SIM_READY_WAIT_US * SIM_MHZ;
+    }
+    simDwt.CYCCNT += 2u * SIM_NIBBLE_CYCLES;
+    simNibbles += 2u;
+    Sim_LcdByte(data, value);
+}
+
+void LCD_WriteControl(uint8 cByte)
+{
+    Sim_Blocking(0u, cByte);
+}
+
+void LCD_WriteData(uint8 dByte)
+{
+    Sim_Blocking(1u, dByte);
+}
+
+// lcd_async.c holds E high for CyDelayUs(1), which is when the nibble is latched
+void CyDelayUs(uint16 microseconds)
+{
+    (void)microseconds;
+    if (0u == (simLcdPort & LCD_E))
+    {
+        return;
+    }
+
+    simNibbles++;
+    if (0u == simHaveHigh)
+    {
+        if (0u != Sim_Busy())
+        {
+            simEarly++;
+        }
+        simHigh = simLcdPort & LCD_DATA_MASK;
+        simHaveHigh = 1u;
+    }
+    else
+    {
+        simHaveHigh = 0u;
+        Sim_LcdByte((uint8)(simLcdPort & LCD_RS),
+                    (uint8)((simHigh << LCD_NIBBLE_SHIFT) | (simLcdPort & LCD_DATA_MASK)));
+    }
+}
+
+uint8 CyEnterCriticalSection(void)
+{
+    simDwt.CYCCNT += SIM_PUT_CYCLES;
+    return 0u;
+}
+
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    (void)savedIntrStatus;
+}
+
+void LCD_Timer_Init(void)
+{
+}
+
+void LCD_Timer_Enable(void)
+{
+    simTimerOn = 1u;
+}
+
+void LCD_Timer_Stop(void)
+{
+    simTimerOn = 0u;
+}
+
+uint8 LCD_Timer_ReadStatusRegister(void)
+{
+    return 0u;
+}
+
+void isr_LCD_StartEx(cyisraddress address)
+{
+    simIsr = address;
+}
+
+static uint8 Sim_Shows(const sim_screen_t *screen)
+{
+    uint8 row;
+    uint8 col;
+
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        const char *text = (NULL != screen->rows[row]) ? screen->rows[row] : "";
+        const char8 *cells = &simDdram[(0u == row) ? 0u : SIM_ROW_1];
+
+        for (col = 0u; col < LCD_FB_COLS; col++)
+        {
+            if (cells[col] != ((col < strlen(text)) ? text[col] : ' '))
+            {
+                return 0u;
+            }
+        }
+    }
+    return 1u;
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-44s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(void)
+{
+    uint32 flushCycles[SIM_SCREENS] = { 0u };
+    uint32 isrCycles[SIM_SCREENS] = { 0u };
+    uint32 doneCycles[SIM_SCREENS] = { 0u };
+    uint32 bytes[SIM_SCREENS] = { 0u };
+    uint32 totalCpu = 0u;
+    uint32 totalDone = 0u;
+    uint32 start;
+    uint32 nibbles;
+    uint32 round;
+    uint32 i;
+    uint8 row;
+    uint8 failed = 0u;
+    uint8 shows = 1u;
+
+    (void)memset(simDdram, ' ', sizeof(simDdram));
+    LcdFb_Init();
+
+    for (round = 0u; round < SIM_ROUNDS; round++)
+    {
+        for (i = 0u; i < SIM_SCREENS; i++)
+        {
+            LcdFb_Clear();
+            for (row = 0u; row < LCD_FB_ROWS; row++)
+            {
+                if (NULL != simScreens[i].rows[row])
+                {
+                    LcdFb_Position(row, 0u);
+                    LcdFb_PrintString(simScreens[i].rows[row]);
+                }
+            }
+
+            start = simDwt.CYCCNT;
+            bytes[i] += LcdFb_Flush();
+            flushCycles[i] += LcdFb_LastFlushCycles();
+
+            // the queued build clocks the bytes out from the timer afterwards
+            while (0u != simTimerOn)
+            {
+                simDwt.CYCCNT += LCD_ASYNC_TICK_US * SIM_MHZ;
+                nibbles = simNibbles;
+                simIsr();
+                isrCycles[i] += SIM_ISR_CYCLES + ((simNibbles - nibbles) * SIM_NIBBLE_CYCLES);
+            }
+            if (0u != Sim_Busy())
+            {
+                simDwt.CYCCNT = simBusyUntil;
+            }
+            doneCycles[i] += simDwt.CYCCNT - start;
+            shows &= Sim_Shows(&simScreens[i]);
+
+            // the game leaves a screen up for at least a second
+            simDwt.CYCCNT += 1000u * 1000u * SIM_MHZ;
+        }
+    }
+
+    printf("%s lcd_async, %u rounds, CPU at %u MHz, cycle costs estimated\n\n",
+        (0u != LCD_ASYNC_ENABLE) ? "queued" : "blocking", SIM_ROUNDS, SIM_MHZ);
+    printf("%-14s %7s %12s %12s %12s %12s\n", "per update", "bytes", "flush us",
+        "interrupt us", "CPU us", "LCD done us");
+    for (i = 0u; i < SIM_SCREENS; i++)
+    {
+        totalCpu += flushCycles[i] + isrCycles[i];
+        totalDone += doneCycles[i];
+        printf("%-14s %7.1f %12.1f %12.1f %12.1f %12.1f\n", simScreens[i].name,
+            (double)bytes[i] / SIM_ROUNDS,
+            (double)flushCycles[i] / (SIM_ROUNDS * SIM_MHZ),
+            (double)isrCycles[i] / (SIM_ROUNDS * SIM_MHZ),
+            (double)(flushCycles[i] + isrCycles[i]) / (SIM_ROUNDS * SIM_MHZ),
+            (double)doneCycles[i] / (SIM_ROUNDS * SIM_MHZ));
+    }
+    printf("%-14s %7s %12s %12s %12.1f %12.1f\n\n", "mean", "", "", "",
+        (double)totalCpu / (SIM_ROUNDS * SIM_SCREENS * SIM_MHZ),
+        (double)totalDone / (SIM_ROUNDS * SIM_SCREENS * SIM_MHZ));
+
+    failed |= Sim_Check(shows, "the display shows every screen");
+    failed |= Sim_Check((uint8)(0u == simEarly), "no byte while the controller is busy");
+    failed |= Sim_Check((uint8)(simNibbles == (2u * simBytes)), "every byte sent as two nibbles");
+
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,300 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host benchmark of the casino's LCD traffic. Games run through game.c and
+ * every state change draws its screen with the firmware's screens.c,
+ * lcd_screen.c and lcd_fb.c. lcd_async is replaced by an HD44780 model
+ * that counts the bytes and keeps the DDRAM, so the test also checks that
+ * the display ends up showing exactly the expected text.
+ *
+ * The bytes are compared with drawing the same screens the way the
+ * original firmware did: LCD_ClearDisplay(), then LCD_Position() and
+ * LCD_PrintString() for each row of text. That sends few bytes, but every
+ * clear keeps the controller busy for 1.52 ms, so the LCD busy time (two
+ * nibble ticks per byte, plus the clear time) is reported as well.
+ *
+ *   gcc -O2 -I. -I../Design01.cydsn -DRNG_HARDWARE_SEED=0 \
+ *       -DADC_SCALE_RESOLUTION=8 -DADC_SCALE_FULL_MV=5000 \
+ *       lcd_bench.c ../Design01.cydsn/screens.c ../Design01.cydsn/lcd_screen.c \
+ *       ../Design01.cydsn/lcd_fb.c ../Design01.cydsn/game.c \
+ *       ../Design01.cydsn/rules.c ../Design01.cydsn/prime.c \
+ *       ../Design01.cydsn/rng.c ../Design01.cydsn/adc_scale.c -o lcd_bench
+ *   ./lcd_bench [games] [seed]
+ *
+ * Add -DLCD_FB_CLEAR_COST=0xFFFF to see the cell diff without clears, or
+ * -DLCD_FB_CLEAR_COST=15 to trade bytes for less clear time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "adc_scale.h"
+#include "game.h"
+#include "lcd_async.h"
+#include "lcd_fb.h"
+#include "rng.h"
+#include "screens.h"
+
+#define SIM_DEFAULT_GAMES   (1000u)
+#define SIM_DDRAM           (0x80u)
+#define SIM_ROW_1           (0x40u)
+
+static char8 simDdram[SIM_DDRAM];
+static uint8 simAddr = 0u;
+static uint32 simBytes = 0u;
+static uint32 simClears = 0u;
+
+static rng_t simRng;
+static uint32 simGames = 0u;
+static uint8 simFailed = 0u;
+
+static uint32 simChanges[GAME_STATE_COUNT];
+static uint32 simNew[GAME_STATE_COUNT];
+static uint32 simDirect[GAME_STATE_COUNT];
+
+static const char8 * const simStateNames[GAME_STATE_COUNT] =
+{
+    "welcome", "turn", "roll", "master", "score", "rest", "winner"
+};
+
+// HD44780 model: DDRAM write, set DDRAM address, clear display
+void LcdAsync_WriteControl(uint8 cByte)
+{
+    simBytes++;
+    if (LCD_CLEAR_DISPLAY == cByte)
+    {
+        (void)memset(simDdram, ' ', sizeof(simDdram));
+        simAddr = 0u;
+        simClears++;
+    }
+    else if (0u != (cByte & 0x80u))
+    {
+        simAddr = cByte & 0x7Fu;
+    }
+}
+
+void LcdAsync_WriteData(uint8 dByte)
+{
+    simBytes++;
+    simDdram[simAddr] = (char8)dByte;
+    simAddr = (simAddr + 1u) & 0x7Fu;
+}
+
+void LcdAsync_Position(uint8 row, uint8 column)
+{
+    LcdAsync_WriteControl((uint8)(((0u == row) ? LCD_ROW_0_START : LCD_ROW_1_START) + column));
+}
+
+void LcdAsync_Start(void)
+{
+    (void)memset(simDdram, ' ', sizeof(simDdram));
+}
+
+static char8 const *Sim_Row(uint8 row)
+{
+    return &simDdram[(0u == row) ? 0u : SIM_ROW_1];
+}
+
+// Clear, then position and print from the first to the last character of each row
+static uint32 Sim_DirectBytes(void)
+{
+    char8 const *cells;
+    uint32 bytes = 1u;
+    uint8 row;
+    int first;
+    int last;
+
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        cells = Sim_Row(row);
+        first = -1;
+        last = -1;
+        for (int col = 0; col < (int)LCD_FB_COLS; col++)
+        {
+            if (' ' != cells[col])
+            {
+                if (first < 0)
+                {
+                    first = col;
+                }
+                last = col;
+            }
+        }
+        if (first >= 0)
+        {
+            bytes += 1u + (uint32)(last - first + 1);
+        }
+    }
+    return bytes;
+}
+
+static void Sim_Expect(const game_t *game, char8 rows[LCD_FB_ROWS][LCD_FB_COLS + 8u])
+{
+    const player_t *player = &game->players[game->player];
+
+    (void)memset(rows, 0, LCD_FB_ROWS * (LCD_FB_COLS + 8u));
+    switch (game->state)
+    {
+        case GAME_STATE_WELCOME:
+            (void)snprintf(rows[0], LCD_FB_COLS + 8u, "    Welcome");
+            #if (GAME_PLAYERS == 2u)
+                (void)snprintf(rows[1], LCD_FB_COLS + 8u, "  P1: %u P2: %u",
+                    game->players[0].score, game->players[1].score);
+            #endif /* GAME_PLAYERS == 2u */
+            break;
+        case GAME_STATE_TURN:
+            (void)snprintf(rows[0], LCD_FB_COLS + 8u, "TURN: P%u", game->player + 1u);
+            break;
+        case GAME_STATE_ROLL:
+            (void)snprintf(rows[0], LCD_FB_COLS + 8u, "    %u", player->lastRoll);
+            break;
+        case GAME_STATE_MASTER:
+            (void)snprintf(rows[0], LCD_FB_COLS + 8u, "MASTER MOVE: P%u!!", game->player + 1u);
+            break;
+        case GAME_STATE_SCORE:
+            (void)snprintf(rows[0], LCD_FB_COLS + 8u, "    P%u: %u", game->player + 1u, player->score);
+            break;
+        case GAME_STATE_WINNER:
+            (void)snprintf(rows[1], LCD_FB_COLS + 8u, "    Winner: P%u :))", game->winner + 1u);
+            break;
+        default:
+            break;
+    }
+}
+
+static uint8 Sim_ReadKnob(void)
+{
+    return AdcScale_ToPercent((uint16)Rng_Bounded(&simRng, ADC_SCALE_MAX_COUNT + 1u));
+}
+
+static uint8 Sim_Random(uint8 range)
+{
+    return (uint8)Rng_Bounded(&simRng, range);
+}
+
+static void Sim_Enter(const game_t *game)
+{
+    char8 expect[LCD_FB_ROWS][LCD_FB_COLS + 8u];
+    uint32 before = simBytes;
+    uint16 reported;
+    uint8 row;
+    uint8 col;
+
+    reported = Screens_Show(game);
+    if ((uint32)reported != (simBytes - before))
+    {
+        simFailed = 1u;
+    }
+
+    // REST keeps the score screen up, nothing to send
+    if (GAME_STATE_REST == game->state)
+    {
+        return;
+    }
+
+    Sim_Expect(game, expect);
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        for (col = 0u; col < LCD_FB_COLS; col++)
+        {
+            char8 want = (col < strlen(expect[row])) ? expect[row][col] : ' ';
+            if (Sim_Row(row)[col] != want)
+            {
+                simFailed = 1u;
+            }
+        }
+    }
+
+    simChanges[game->state]++;
+    simNew[game->state] += simBytes - before;
+    simDirect[game->state] += Sim_DirectBytes();
+
+    if (GAME_STATE_WINNER == game->state)
+    {
+        simGames++;
+    }
+}
+
+static const game_io_t simIo =
+{
+    &Sim_ReadKnob,
+    &Sim_Random,
+    &Sim_Enter
+};
+
+int main(int argc, char *argv[])
+{
+    uint32 games = SIM_DEFAULT_GAMES;
+    uint64 seed = 1u;
+    uint32 changes = 0u;
+    uint32 bytesNew = 0u;
+    uint32 bytesDirect = 0u;
+    game_t game;
+    uint8 fewer = 1u;
+    uint8 i;
+
+    if (argc > 1)
+    {
+        games = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        seed = strtoull(argv[2], NULL, 0);
+    }
+
+    Rng_Seed(&simRng, seed, 0u);
+    LcdFb_Init();
+    Game_Init(&game, &simIo, &Rules_classic, 0u);
+    while (simGames < games)
+    {
+        Game_Run(&game, Game_NextDeadline(&game));
+    }
+
+    printf("%u games, clear display costed as %u bytes\n\n", simGames, (uint32)LCD_FB_CLEAR_COST);
+    printf("%-8s %8s %14s %14s\n", "screen", "changes", "direct B/chg", "template B/chg");
+    for (i = 0u; i < GAME_STATE_COUNT; i++)
+    {
+        if (0u == simChanges[i])
+        {
+            continue;
+        }
+        printf("%-8s %8u %14.2f %14.2f\n", simStateNames[i], simChanges[i],
+            (double)simDirect[i] / (double)simChanges[i], (double)simNew[i] / (double)simChanges[i]);
+        fewer &= (simNew[i] <= simDirect[i]) ? 1u : 0u;
+        changes += simChanges[i];
+        bytesNew += simNew[i];
+        bytesDirect += simDirect[i];
+    }
+    printf("%-8s %8u %14.2f %14.2f\n", "all", changes,
+        (double)bytesDirect / (double)changes, (double)bytesNew / (double)changes);
+    printf("\nLCD busy per change: direct %.0f us, template %.0f us (%u clear display commands)\n",
+        ((double)bytesDirect * 2.0 * LCD_ASYNC_TICK_US + (double)changes * LCD_ASYNC_SLOW_CMD_US) /
+        (double)changes,
+        ((double)bytesNew * 2.0 * LCD_ASYNC_TICK_US + (double)simClears * LCD_ASYNC_SLOW_CMD_US) /
+        (double)changes, simClears);
+    printf("display matches the expected text: %s\n", (0u == simFailed) ? "ok" : "FAILED");
+
+    // only a byte-costed clear promises that
+    if (LCD_FB_CLEAR_COST <= 1u)
+    {
+        printf("no screen sends more bytes than direct: %s\n", (0u != fewer) ? "ok" : "FAILED");
+        simFailed |= (uint8)(0u == fewer);
+    }
+
+    return (0u != simFailed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
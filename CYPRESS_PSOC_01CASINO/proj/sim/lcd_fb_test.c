@@ -0,0 +1,252 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host test of the LCD shadow framebuffer. lcd_fb.c and lcd_async.c are
+ * built with LCD_ASYNC_ENABLE 0, so every byte ends in LCD_WriteControl()
+ * or LCD_WriteData(). Those are mocked here by an HD44780 model that keeps
+ * the DDRAM and counts the bus transactions.
+ *
+ * A script of typical casino and lock screens is drawn twice:
+ *  - through LcdFb_Flush()
+ *  - the way the firmware used to draw it: LCD_ClearDisplay(), then
+ *    LCD_Position() and LCD_PrintString() for each line of text
+ * After each screen the display has to show exactly the script's text. The
+ * bytes and the controller busy time of both ways are reported per screen.
+ * Busy time is counted as 37 us per byte and 1.52 ms per clear display.
+ *
+ *   gcc -O2 -Wall -Wextra -I. -I../Design01.cydsn -DLCD_ASYNC_ENABLE=0 \
+ *       lcd_fb_test.c ../Design01.cydsn/lcd_fb.c ../Design01.cydsn/lcd_async.c \
+ *       -o lcd_fb_test
+ *   ./lcd_fb_test
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "lcd_fb.h"
+
+#define SIM_DDRAM           (0x80u)
+#define SIM_ROW_1           (0x40u)
+#define SIM_BYTE_US         (37u)
+#define SIM_CLEAR_US        (1520u)
+
+typedef struct
+{
+    const char *name;
+    const char *rows[LCD_FB_ROWS];      // NULL leaves the row blank
+} sim_screen_t;
+
+static const sim_screen_t simScript[] =
+{
+    { "casino welcome", { "    Welcome", "  P1: 0 P2: 0" } },
+    { "turn",           { "TURN: P1", NULL } },
+    { "roll",           { "    37", NULL } },
+    { "master move",    { "MASTER MOVE: P1!!", NULL } },
+    { "score",          { "    P1: 20", NULL } },
+    { "same again",     { "    P1: 20", NULL } },
+    { "turn",           { "TURN: P2", NULL } },
+    { "roll",           { "    50", NULL } },
+    { "score",          { "    P2: 7", NULL } },
+    { "turn",           { "TURN: P1", NULL } },
+    { "roll",           { "    4", NULL } },
+    { "score",          { "    P1: 27", NULL } },
+    { "winner",         { NULL, "    Winner: P1 :))" } },
+    { "welcome",        { "    Welcome", "  P1: 27 P2: 7" } },
+    { "lock match",     { "Password Match:", "User 3" } },
+    { "lock open",      { "Lock is open", "Access granted" } },
+    { "lock invalid",   { "Invalid Password", NULL } },
+    { "lock denied",    { "Access denied", NULL } },
+    { "lock retry",     { "Enter Correct", "Password" } },
+    { "lock match",     { "Password Match:", "User 12" } },
+};
+
+#define SIM_SCREENS (sizeof(simScript) / sizeof(simScript[0]))
+
+static char8 simDdram[SIM_DDRAM];
+static uint8 simAddr = 0u;
+static uint32 simControl = 0u;
+static uint32 simData = 0u;
+static uint32 simClears = 0u;
+
+// HD44780 model: DDRAM write, set DDRAM address, clear display
+void LCD_WriteControl(uint8 cByte)
+{
+    simControl++;
+    if (LCD_CLEAR_DISPLAY == cByte)
+    {
+        (void)memset(simDdram, ' ', sizeof(simDdram));
+        simAddr = 0u;
+        simClears++;
+    }
+    else if (0u != (cByte & 0x80u))
+    {
+        simAddr = cByte & 0x7Fu;
+    }
+}
+
+void LCD_WriteData(uint8 dByte)
+{
+    simData++;
+    simDdram[simAddr] = (char8)dByte;
+    simAddr = (simAddr + 1u) & 0x7Fu;
+}
+
+static uint32 Sim_Bytes(void)
+{
+    return simControl + simData;
+}
+
+static uint32 Sim_BusyUs(void)
+{
+    return ((Sim_Bytes() - simClears) * SIM_BYTE_US) + (simClears * SIM_CLEAR_US);
+}
+
+static void Sim_Reset(void)
+{
+    (void)memset(simDdram, ' ', sizeof(simDdram));
+    simAddr = 0u;
+    simControl = 0u;
+    simData = 0u;
+    simClears = 0u;
+}
+
+static uint8 Sim_Shows(const sim_screen_t *screen)
+{
+    uint8 row;
+    uint8 col;
+
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        const char *text = (NULL != screen->rows[row]) ? screen->rows[row] : "";
+        const char8 *cells = &simDdram[(0u == row) ? 0u : SIM_ROW_1];
+
+        for (col = 0u; col < LCD_FB_COLS; col++)
+        {
+            char8 want = (col < strlen(text)) ? text[col] : ' ';
+
+            if (cells[col] != want)
+            {
+                return 0u;
+            }
+        }
+    }
+    return 1u;
+}
+
+// LCD_ClearDisplay(), LCD_Position() and LCD_PrintString() as in the old main.c
+static void Sim_DrawDirect(const sim_screen_t *screen)
+{
+    const char *text;
+    uint8 row;
+
+    LCD_WriteControl(LCD_CLEAR_DISPLAY);
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        if (NULL != screen->rows[row])
+        {
+            LCD_WriteControl((uint8)((0u == row) ? LCD_ROW_0_START : LCD_ROW_1_START));
+            for (text = screen->rows[row]; '\0' != *text; text++)
+            {
+                LCD_WriteData((uint8)*text);
+            }
+        }
+    }
+}
+
+static uint16 Sim_DrawShadow(const sim_screen_t *screen)
+{
+    uint8 row;
+
+    LcdFb_Clear();
+    for (row = 0u; row < LCD_FB_ROWS; row++)
+    {
+        if (NULL != screen->rows[row])
+        {
+            LcdFb_Position(row, 0u);
+            LcdFb_PrintString(screen->rows[row]);
+        }
+    }
+    return LcdFb_Flush();
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-44s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(void)
+{
+    uint32 directBytes[SIM_SCREENS];
+    uint32 directUs[SIM_SCREENS];
+    uint32 totalDirectBytes = 0u;
+    uint32 totalDirectUs = 0u;
+    uint32 totalBytes = 0u;
+    uint32 totalUs = 0u;
+    uint32 bytes;
+    uint32 us;
+    uint32 i;
+    uint8 failed = 0u;
+    uint8 directShows = 1u;
+    uint8 shows = 1u;
+    uint8 reported = 1u;
+    uint8 repeatFree = 1u;
+
+    Sim_Reset();
+    for (i = 0u; i < SIM_SCREENS; i++)
+    {
+        bytes = Sim_Bytes();
+        us = Sim_BusyUs();
+        Sim_DrawDirect(&simScript[i]);
+        directBytes[i] = Sim_Bytes() - bytes;
+        directUs[i] = Sim_BusyUs() - us;
+        directShows &= Sim_Shows(&simScript[i]);
+        totalDirectBytes += directBytes[i];
+        totalDirectUs += directUs[i];
+    }
+
+    Sim_Reset();
+    LcdFb_Init();
+    printf("%-16s %14s %14s %12s %12s\n", "screen", "direct bytes", "shadow bytes",
+        "direct us", "shadow us");
+    for (i = 0u; i < SIM_SCREENS; i++)
+    {
+        bytes = Sim_Bytes();
+        us = Sim_BusyUs();
+        reported &= ((uint32)Sim_DrawShadow(&simScript[i]) == (Sim_Bytes() - bytes)) ? 1u : 0u;
+        bytes = Sim_Bytes() - bytes;
+        us = Sim_BusyUs() - us;
+        shows &= Sim_Shows(&simScript[i]);
+        if ((i > 0u) && (0 == memcmp(&simScript[i].rows, &simScript[i - 1u].rows, sizeof(simScript[i].rows))))
+        {
+            repeatFree &= (0u == bytes) ? 1u : 0u;
+        }
+        totalBytes += bytes;
+        totalUs += us;
+        printf("%-16s %14u %14u %12u %12u\n", simScript[i].name, directBytes[i], bytes, directUs[i], us);
+    }
+    printf("%-16s %14u %14u %12u %12u\n\n", "all", totalDirectBytes, totalBytes, totalDirectUs, totalUs);
+    printf("shadow: %u control, %u data, %u clear display\n\n", simControl, simData, simClears);
+
+    failed |= Sim_Check(directShows, "the direct drawing shows the script");
+    failed |= Sim_Check(shows, "the flushed shadow shows the script");
+    failed |= Sim_Check(reported, "LcdFb_Flush() returns the bytes sent");
+    failed |= Sim_Check(repeatFree, "an unchanged screen sends nothing");
+    failed |= Sim_Check((uint8)(totalUs < totalDirectUs), "less LCD busy time than the direct drawing");
+
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host check of the flash prime table. Prime_IsPrime() is compared with a
+ * sieve of Eratosthenes over 0..4096, one past PRIME_TABLE_MAX, and every
+ * larger uint16 must read as not prime.
+ *
+ *   gcc -O2 -Wall -Wextra -I. -I../Design01.cydsn \
+ *       prime_test.c ../Design01.cydsn/prime.c -o prime_test
+ *   ./prime_test
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "prime.h"
+
+#define SIM_SIEVE_MAX   (4096u)
+
+static uint8 sieve[SIM_SIEVE_MAX + 1u];
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-44s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(void)
+{
+    uint32 n;
+    uint32 m;
+    uint32 primes = 0u;
+    uint32 mismatches = 0u;
+    uint8 failed = 0u;
+    uint8 above = 1u;
+
+    (void)memset(sieve, 1, sizeof(sieve));
+    sieve[0] = 0u;
+    sieve[1] = 0u;
+    for (n = 2u; (n * n) <= SIM_SIEVE_MAX; n++)
+    {
+        if (0u != sieve[n])
+        {
+            for (m = n * n; m <= SIM_SIEVE_MAX; m += n)
+            {
+                sieve[m] = 0u;
+            }
+        }
+    }
+
+    for (n = 0u; n <= SIM_SIEVE_MAX; n++)
+    {
+        uint8 expected = (n <= PRIME_TABLE_MAX) ? sieve[n] : 0u;
+
+        primes += sieve[n];
+        if (Prime_IsPrime((uint16)n) != expected)
+        {
+            if (mismatches < 10u)
+            {
+                printf("  %u: table %u, sieve %u\n", n, Prime_IsPrime((uint16)n), sieve[n]);
+            }
+            mismatches++;
+        }
+    }
+    for (n = PRIME_TABLE_MAX + 1u; n <= 0xFFFFu; n++)
+    {
+        above &= (0u == Prime_IsPrime((uint16)n)) ? 1u : 0u;
+    }
+
+    printf("%u primes up to %u, table of %u bytes\n\n", primes, SIM_SIEVE_MAX,
+        (uint32)sizeof(Prime_table));
+    failed |= Sim_Check(0u == mismatches, "table matches the sieve over 0..4096");
+    failed |= Sim_Check(above, "nothing above PRIME_TABLE_MAX is prime");
+
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
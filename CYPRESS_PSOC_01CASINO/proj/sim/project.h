@@ -0,0 +1,78 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef PROJECT_H
+#define PROJECT_H
+
+/*
+ * Host stand-in for Generated_Source/PSoC5/project.h, just what the
+ * portable LCD modules use: the LCD component's constants and port, the
+ * LCD_Timer and isr_LCD of lcd_async.c, CyLib and the DWT cycle counter.
+ * Their hardware calls are provided by the test that links them.
+ */
+
+#include <string.h>     // CyLib.h includes it, so project.h users get NULL
+#include "cytypes.h"
+
+#define BCLK__BUS_CLK__HZ   (24000000u)
+
+// LCD.h
+#define LCD_CLEAR_DISPLAY           (0x01u)
+#define LCD_RESET_CURSOR_POSITION   (0x03u)
+#define LCD_ROW_0_START             (0x80u)
+#define LCD_ROW_1_START             (0xC0u)
+#define LCD_NIBBLE_SHIFT            (0x04u)
+#define LCD_PORT_SHIFT              (0x00u)
+#define LCD_RS                      ((uint8)0x20u)
+#define LCD_RW                      ((uint8)0x40u)
+#define LCD_E                       ((uint8)0x10u)
+#define LCD_DATA_MASK               ((uint8)0x0Fu)
+
+extern uint8 simLcdPort;
+#define LCD_PORT_DR_REG             (simLcdPort)
+
+void LCD_WriteControl(uint8 cByte);
+void LCD_WriteData(uint8 dByte);
+
+// LCD_Timer and isr_LCD
+void LCD_Timer_Init(void);
+void LCD_Timer_Enable(void);
+void LCD_Timer_Stop(void);
+uint8 LCD_Timer_ReadStatusRegister(void);
+void isr_LCD_StartEx(cyisraddress address);
+
+// CyLib
+void CyDelayUs(uint16 microseconds);
+uint8 CyEnterCriticalSection(void);
+void CyExitCriticalSection(uint8 savedIntrStatus);
+
+// core_cm3.h cycle counter
+typedef struct
+{
+    volatile uint32 CTRL;
+    volatile uint32 CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32 DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type simDwt;
+extern CoreDebug_Type simCoreDebug;
+
+#define DWT                             (&simDwt)
+#define CoreDebug                       (&simCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk          (1uL)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1uL << 24)
+
+#endif /* PROJECT_H */
+/* [] END OF FILE */
@@ -0,0 +1,284 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host statistical test and benchmark of rng.c.
+ *
+ * The generator is checked against the reference PCG32 output, then its
+ * raw words and its Rng_Bounded() rolls go through a few classic tests
+ * (bucket and pair chi-square, per-bit frequency, serial correlation,
+ * stream independence). Each test reports a p-value and fails below
+ * 0.0001.
+ *
+ * The timing part compares the cost per number with newlib's rand(),
+ * which the firmware used before: a 64-bit LCG returning bits 32..62,
+ * rebuilt here from newlib/libc/stdlib/rand.c since the host C library is
+ * glibc. glibc's own rand() is timed too. Cycles are the x86 time stamp
+ * counter, so they are only a guide to the Cortex-M3, where the 64-bit
+ * multiply of both generators is three MUL/UMULL instructions.
+ *
+ *   gcc -O2 -Wall -Wextra -I. -I../Design01.cydsn -DRNG_HARDWARE_SEED=0 \
+ *       rng_test.c ../Design01.cydsn/rng.c -lm -o rng_test
+ *   ./rng_test [samples in millions] [seed]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <x86intrin.h>
+
+#include "cytypes.h"
+#include "rng.h"
+
+#define SIM_DEFAULT_MILLIONS    (16u)
+#define SIM_P_FAIL              (0.0001)
+#define SIM_ROLL_RANGE          (96u)       // the re-roll range in main.c
+#define SIM_PAIR_RANGE          (16u)
+#define SIM_BENCH_COUNT         (10000000u)
+
+static uint64 simNewlibNext;
+
+// newlib rand(): next = next * 6364136223846793005 + 1, bits 32..62
+static uint32 Sim_NewlibRand(void)
+{
+    simNewlibNext = (simNewlibNext * 6364136223846793005ull) + 1u;
+    return (uint32)((simNewlibNext >> 32u) & 0x7FFFFFFFu);
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-44s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+// Upper tail of the chi-square distribution, Wilson-Hilferty approximation.
+static double Sim_ChiSquareP(double chi2, uint32 dof)
+{
+    double k = (double)dof;
+    double z = (pow(chi2 / k, 1.0 / 3.0) - (1.0 - (2.0 / (9.0 * k)))) / sqrt(2.0 / (9.0 * k));
+
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+// Two-sided p-value of a standard normal z.
+static double Sim_NormalP(double z)
+{
+    return erfc(fabs(z) / sqrt(2.0));
+}
+
+static double Sim_ChiSquare(const uint64 counts[], uint32 buckets, uint64 total)
+{
+    double expected = (double)total / (double)buckets;
+    double chi2 = 0.0;
+    uint32 i;
+
+    for (i = 0u; i < buckets; i++)
+    {
+        double d = (double)counts[i] - expected;
+
+        chi2 += (d * d) / expected;
+    }
+    return chi2;
+}
+
+static uint8 Sim_Report(const char *what, double p)
+{
+    char line[64];
+
+    (void)snprintf(line, sizeof(line), "%s, p = %.4f", what, p);
+    return Sim_Check((uint8)(p >= SIM_P_FAIL), line);
+}
+
+static uint64 rolls[SIM_ROLL_RANGE];
+static uint64 bytes[256];
+static uint64 pairs[SIM_PAIR_RANGE * SIM_PAIR_RANGE];
+static uint64 bits[32];
+
+int main(int argc, char *argv[])
+{
+    static const uint32 reference[6] =
+    {
+        0xA15C02B7u, 0x7B47F409u, 0xBA1D3330u, 0x83D2F293u, 0xBFA4784Bu, 0xCBED606Eu
+    };
+    uint32 millions = SIM_DEFAULT_MILLIONS;
+    uint64 seed = 1u;
+    uint64 n;
+    uint64 i;
+    uint32 b;
+    uint32 x;
+    uint32 prev;
+    uint32 pairPrev;
+    uint32 same = 0u;
+    uint8 failed = 0u;
+    uint8 matches = 1u;
+    double sumXY = 0.0;
+    double sumX = 0.0;
+    double sumXX = 0.0;
+    double r;
+    double worstBitP = 1.0;
+    rng_t rng;
+    rng_t other;
+
+    if (argc > 1)
+    {
+        millions = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        seed = strtoull(argv[2], NULL, 0);
+    }
+    if (0u == millions)
+    {
+        millions = 1u;
+    }
+    n = (uint64)millions * 1000000u;
+
+    // pcg32-demo: pcg32_srandom_r(&rng, 42u, 54u)
+    Rng_Seed(&rng, 42u, 54u);
+    for (b = 0u; b < 6u; b++)
+    {
+        matches &= (Rng_Next(&rng) == reference[b]) ? 1u : 0u;
+    }
+
+    printf("%u million numbers of each kind, seed %llu\n\n", millions, (unsigned long long)seed);
+    failed |= Sim_Check(matches, "matches the reference PCG32 output");
+
+    // raw words: bytes, bits and serial correlation
+    Rng_Seed(&rng, seed, 0u);
+    prev = Rng_Next(&rng);
+    for (i = 0u; i < n; i++)
+    {
+        x = Rng_Next(&rng);
+        for (b = 0u; b < 4u; b++)
+        {
+            bytes[(x >> (8u * b)) & 0xFFu]++;
+        }
+        for (b = 0u; b < 32u; b++)
+        {
+            bits[b] += (x >> b) & 1u;
+        }
+        sumX += (double)x;
+        sumXX += (double)x * (double)x;
+        sumXY += (double)prev * (double)x;
+        prev = x;
+    }
+    failed |= Sim_Report("bytes over 256 buckets", Sim_ChiSquareP(Sim_ChiSquare(bytes, 256u, 4u * n), 255u));
+    for (b = 0u; b < 32u; b++)
+    {
+        double p = Sim_NormalP(((double)bits[b] - ((double)n / 2.0)) / sqrt((double)n / 4.0));
+
+        // 32 tests, so the worst one is corrected for the count
+        p *= 32.0;
+        if (p < worstBitP)
+        {
+            worstBitP = p;
+        }
+    }
+    failed |= Sim_Report("worst of the 32 bit frequencies", (worstBitP > 1.0) ? 1.0 : worstBitP);
+    r = ((sumXY / (double)n) - ((sumX / (double)n) * (sumX / (double)n))) /
+        ((sumXX / (double)n) - ((sumX / (double)n) * (sumX / (double)n)));
+    failed |= Sim_Report("serial correlation", Sim_NormalP(r * sqrt((double)n)));
+
+    // the rolls the game makes, and pairs of consecutive small rolls
+    Rng_Seed(&rng, seed, 1u);
+    pairPrev = Rng_Bounded(&rng, SIM_PAIR_RANGE);
+    for (i = 0u; i < n; i++)
+    {
+        rolls[Rng_Bounded(&rng, SIM_ROLL_RANGE)]++;
+        x = Rng_Bounded(&rng, SIM_PAIR_RANGE);
+        pairs[(pairPrev * SIM_PAIR_RANGE) + x]++;
+        pairPrev = x;
+    }
+    failed |= Sim_Report("Rng_Bounded(96) over 96 buckets",
+        Sim_ChiSquareP(Sim_ChiSquare(rolls, SIM_ROLL_RANGE, n), SIM_ROLL_RANGE - 1u));
+    failed |= Sim_Report("Rng_Bounded(16) pairs",
+        Sim_ChiSquareP(Sim_ChiSquare(pairs, SIM_PAIR_RANGE * SIM_PAIR_RANGE, n),
+                       (SIM_PAIR_RANGE * SIM_PAIR_RANGE) - 1u));
+
+    // same seed, neighbouring streams, as two boards with close unique IDs
+    Rng_Seed(&rng, seed, 2u);
+    Rng_Seed(&other, seed, 3u);
+    for (i = 0u; i < n; i++)
+    {
+        x = Rng_Bounded(&rng, SIM_ROLL_RANGE);
+        same += (x == Rng_Bounded(&other, SIM_ROLL_RANGE)) ? 1u : 0u;
+    }
+    {
+        double expected = (double)n / (double)SIM_ROLL_RANGE;
+        double sd = sqrt(expected * (1.0 - (1.0 / (double)SIM_ROLL_RANGE)));
+
+        failed |= Sim_Report("streams 2 and 3 independent",
+            Sim_NormalP(((double)same - expected) / sd));
+    }
+
+    // modulo bias of the old rand() % 96, exactly
+    printf("\nrand() %% 96 with RAND_MAX 0x7FFFFFFF: %u values 1 in %.0f more likely\n",
+        (uint32)(0x80000000uL % SIM_ROLL_RANGE), floor((double)0x80000000uL / SIM_ROLL_RANGE));
+    printf("Rng_Bounded(96) retries 1 in %.0f draws and has no bias\n\n",
+        4294967296.0 / (double)((uint32)(0u - SIM_ROLL_RANGE) % SIM_ROLL_RANGE));
+
+    // cost per number
+    {
+        static uint8 batch[1024];
+        volatile uint32 sink = 0u;
+        struct timespec t0;
+        struct timespec t1;
+        uint64 c0;
+        uint32 kind;
+        const char *const names[] =
+        {
+            "Rng_Next()", "Rng_Bounded(&rng, 96)", "Rng_FillBounded(96), 1024",
+            "newlib rand()", "newlib rand() % 96", "glibc rand()", "glibc rand() % 96"
+        };
+
+        printf("  %-28s %10s %10s\n", "per number on this host", "ns", "cycles");
+        Rng_Seed(&rng, seed, 0u);
+        simNewlibNext = seed;
+        srand((unsigned int)seed);
+        for (kind = 0u; kind < (sizeof(names) / sizeof(names[0])); kind++)
+        {
+            (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+            c0 = __rdtsc();
+            for (i = 0u; i < SIM_BENCH_COUNT; i++)
+            {
+                switch (kind)
+                {
+                    case 0u: sink += Rng_Next(&rng); break;
+                    case 1u: sink += Rng_Bounded(&rng, SIM_ROLL_RANGE); break;
+                    case 2u:
+                        Rng_FillBounded(&rng, batch, sizeof(batch), SIM_ROLL_RANGE);
+                        sink += batch[i & 1023u];
+                        i += sizeof(batch) - 1u;
+                        break;
+                    case 3u: sink += Sim_NewlibRand(); break;
+                    case 4u: sink += Sim_NewlibRand() % SIM_ROLL_RANGE; break;
+                    case 5u: sink += (uint32)rand(); break;
+                    default: sink += (uint32)rand() % SIM_ROLL_RANGE; break;
+                }
+            }
+            c0 = __rdtsc() - c0;
+            (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+            printf("  %-28s %10.2f %10.2f\n", names[kind],
+                ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) /
+                    (double)SIM_BENCH_COUNT,
+                (double)c0 / (double)SIM_BENCH_COUNT);
+        }
+        (void)sink;
+    }
+    printf("\n");
+
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,257 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host test of the statistics store. Games are played back to back through
+ * the firmware's game.c, stats.c records them exactly as main.c does, and
+ * the store is a simulated Em_EEPROM: every write of up to STATS_NV_CHUNK
+ * bytes programs the next row of the wear-levelling ring (and its redundant
+ * copy), which on PSoC 5LP always means one erase of that row.
+ *
+ * It checks that the RAM counters match an independent tally, that a
+ * reset reloads exactly what was committed, that a failed write is
+ * retried, and reports erase cycles per 10,000 games.
+ *
+ *   gcc -O2 -I. -I../Design01.cydsn -DRNG_HARDWARE_SEED=0 \
+ *       -DADC_SCALE_RESOLUTION=8 -DADC_SCALE_FULL_MV=5000 \
+ *       stats_test.c ../Design01.cydsn/stats.c ../Design01.cydsn/game.c \
+ *       ../Design01.cydsn/rules.c ../Design01.cydsn/prime.c \
+ *       ../Design01.cydsn/rng.c ../Design01.cydsn/adc_scale.c -o stats_test
+ *   ./stats_test [games] [wear levelling 1..10] [redundant 0/1] [seed]
+ *
+ * Add -DSTATS_GAMES_PER_COMMIT=n to see the effect of other batch sizes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "adc_scale.h"
+#include "game.h"
+#include "rng.h"
+#include "stats.h"
+
+#define SIM_DEFAULT_GAMES   (10000u)
+#define SIM_ROW_DATA        (128u)      // CY_EM_EEPROM_EEPROM_DATA_LEN on PSoC 5LP
+#define SIM_MAX_WEAR        (10u)       // CY_EM_EEPROM_MAX_WEAR_LEVELING_FACTOR
+#define SIM_ROWS            ((sizeof(stats_t) + SIM_ROW_DATA - 1u) / SIM_ROW_DATA)
+#define SIM_FLASH_ENDURANCE (100000u)   // rated program/erase cycles per row
+#define SIM_FAILED_WRITES   (3u)        // the first writes fail to exercise the retry
+
+static uint8 simData[sizeof(stats_t)];  // what Cy_Em_EEPROM_Read() would return
+static uint32 simErases[SIM_ROWS * SIM_MAX_WEAR * 2u];
+static uint32 simWear = 4u;
+static uint32 simRedundant = 1u;
+static uint32 simSeq = 0u;
+static uint32 simReads = 0u;
+static uint32 simWrites = 0u;
+static uint32 simFailures = 0u;
+
+static rng_t simRng;
+static uint32 simGames = 0u;
+static uint32 simWins[GAME_PLAYERS];
+static uint32 simTurns = 0u;
+
+static uint8 Sim_NvRead(uint32 offset, void *dst, uint32 size)
+{
+    simReads++;
+    (void)memcpy(dst, &simData[offset], size);
+    return 0u;
+}
+
+static uint8 Sim_NvWrite(uint32 offset, const void *src, uint32 size)
+{
+    uint32 ring = SIM_ROWS * simWear;
+    uint32 n;
+
+    if (simFailures < SIM_FAILED_WRITES)
+    {
+        simFailures++;
+        return 1u;
+    }
+
+    // Cy_Em_EEPROM_Write() splits the data into one row per STATS_NV_CHUNK
+    for (n = 0u; n < ((size - 1u) / STATS_NV_CHUNK) + 1u; n++)
+    {
+        simErases[simSeq % ring]++;
+        if (0u != simRedundant)
+        {
+            simErases[ring + (simSeq % ring)]++;
+        }
+        simSeq++;
+        simWrites++;
+    }
+
+    (void)memcpy(&simData[offset], src, size);
+    return 0u;
+}
+
+static const stats_nv_t simNv =
+{
+    &Sim_NvRead,
+    &Sim_NvWrite
+};
+
+static uint8 Sim_ReadKnob(void)
+{
+    return AdcScale_ToPercent((uint16)Rng_Bounded(&simRng, ADC_SCALE_MAX_COUNT + 1u));
+}
+
+static uint8 Sim_Random(uint8 range)
+{
+    return (uint8)Rng_Bounded(&simRng, range);
+}
+
+static void Sim_Enter(const game_t *game)
+{
+    switch (game->state)
+    {
+        case GAME_STATE_ROLL:
+            simTurns++;
+            break;
+
+        case GAME_STATE_WINNER:
+            Stats_RecordGame(game);
+            simWins[game->winner]++;
+            simGames++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static const game_io_t simIo =
+{
+    &Sim_ReadKnob,
+    &Sim_Random,
+    &Sim_Enter
+};
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-44s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 games = SIM_DEFAULT_GAMES;
+    uint64 seed = 1u;
+    uint8 failed = 0u;
+    uint8 ordered = 1u;
+    uint8 winsMatch = 1u;
+    uint32 readsBefore;
+    uint32 erases = 0u;
+    uint32 maxErases = 0u;
+    uint32 rows;
+    uint32 i;
+    stats_t before;
+    game_t game;
+
+    if (argc > 1)
+    {
+        games = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        simWear = (uint32)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3)
+    {
+        simRedundant = (0u != strtoul(argv[3], NULL, 0)) ? 1u : 0u;
+    }
+    if (argc > 4)
+    {
+        seed = strtoull(argv[4], NULL, 0);
+    }
+    if ((0u == simWear) || (simWear > SIM_MAX_WEAR))
+    {
+        simWear = SIM_MAX_WEAR;
+    }
+    if (0u == games)
+    {
+        games = 1u;
+    }
+    rows = SIM_ROWS * simWear * (1u + simRedundant);
+
+    printf("%u games, %u-byte record in %u row(s), wear levelling x%u, redundant copy %u, "
+        "%u game(s) per commit\n\n", games, (uint32)sizeof(stats_t), (uint32)SIM_ROWS,
+        simWear, simRedundant, (uint32)STATS_GAMES_PER_COMMIT);
+
+    Rng_Seed(&simRng, seed, 0u);
+    Stats_Init(&simNv);
+    failed |= Sim_Check((0u == Stats_Get()->gamesPlayed) && (STATS_MAGIC == Stats_Get()->magic),
+        "blank store starts from zero");
+
+    // the firmware only services the store on the winner and welcome screens
+    readsBefore = simReads;
+    Game_Init(&game, &simIo, &Rules_classic, 0u);
+    while (simGames < games)
+    {
+        Game_Run(&game, Game_NextDeadline(&game));
+        if ((GAME_STATE_WINNER == game.state) || (GAME_STATE_WELCOME == game.state))
+        {
+            Stats_Service(game.enteredMs);
+        }
+    }
+    // let a partial batch reach its dirty timeout
+    Stats_Service(game.enteredMs + STATS_DIRTY_TIMEOUT_MS);
+
+    failed |= Sim_Check(readsBefore == simReads, "counters read from RAM only");
+    failed |= Sim_Check(SIM_FAILED_WRITES == simFailures, "failed writes are retried");
+    failed |= Sim_Check(0u == Stats_IsDirty(), "everything committed");
+    failed |= Sim_Check(games == Stats_Get()->gamesPlayed, "games played");
+    for (i = 0u; i < GAME_PLAYERS; i++)
+    {
+        winsMatch &= (simWins[i] == Stats_Get()->wins[i]) ? 1u : 0u;
+    }
+    failed |= Sim_Check(winsMatch, "wins per player");
+    for (i = 1u; i < STATS_TOP_N; i++)
+    {
+        ordered &= (Stats_Get()->top[i - 1u].score >= Stats_Get()->top[i].score) ? 1u : 0u;
+    }
+    failed |= Sim_Check(ordered && (0u != Stats_Get()->top[0].score), "top scores in order");
+    failed |= Sim_Check((Stats_Get()->longestStreak >= Stats_Get()->streak) &&
+        (0u != Stats_Get()->longestStreak), "streaks");
+
+    before = *Stats_Get();
+    Stats_Init(&simNv);
+    failed |= Sim_Check(0 == memcmp(&before, Stats_Get(), sizeof(stats_t)), "reset reloads the committed record");
+
+    for (i = 0u; i < rows; i++)
+    {
+        erases += simErases[i];
+        if (simErases[i] > maxErases)
+        {
+            maxErases = simErases[i];
+        }
+    }
+
+    printf("\n%u row writes for %u turns in %u games\n", simWrites, simTurns, simGames);
+    printf("erase cycles per 10,000 games: %.1f in total, %.1f on the most worn row\n",
+        (10000.0 * (double)erases) / (double)simGames,
+        (10000.0 * (double)maxErases) / (double)simGames);
+    printf("  saving after every turn instead: %.1f on the most worn row\n",
+        (10000.0 * (double)simTurns * (double)((sizeof(stats_t) - 1u) / STATS_NV_CHUNK + 1u)) /
+        ((double)simGames * (double)(SIM_ROWS * simWear)));
+    if (0u != maxErases)
+    {
+        printf("games until the most worn row reaches %u cycles: %.0f\n", SIM_FLASH_ENDURANCE,
+            ((double)SIM_FLASH_ENDURANCE * (double)simGames) / (double)maxErases);
+    }
+
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -13,37 +13,113 @@
  */
 #include "project.h"
 #include "stdio.h"
+#include "pad_evt.h"
+
+// A held pad repeats its message this often, as the old 100 ms polling
+// did; 0 sends it once per press
+#ifndef GAME_REPEAT_MS
+    #define GAME_REPEAT_MS  (100u)
+#endif /* GAME_REPEAT_MS */
+
+#define GAME_REPEAT_CYCLES  (GAME_REPEAT_MS * 1000u * PAD_EVT_CYCLES_PER_US)
+
+// What the GUI reads for each pad
+static char8 const * const padMessage[PAD_EVT_PADS] = { "right\n", "left\n" };
+
+// Sends the pad event counts and the queue time histogram, when the
+// host sends '?'; the GUI ignores lines it does not know. USBUART_PutString()
+// waits for the endpoint, this is only for a look on demand.
+static void Game_SendStats(void)
+{
+    pad_evt_stats_t stats;
+    char8 line[80];     // the first line is up to 76 characters with full counts
+    uint8 bin;
+
+    PadEvt_GetStats(&stats);
+    (void)snprintf(line, sizeof(line), "events %lu bounces %lu dropped %lu queue %lu us\n",
+                   (unsigned long)stats.events, (unsigned long)stats.bounces,
+                   (unsigned long)stats.dropped, (unsigned long)stats.worstQueueUs);
+    USBUART_PutString(line);
+
+    for (bin = 0u; bin < PAD_EVT_HIST_BINS; bin++)
+    {
+        if (0u != stats.queueHist[bin])
+        {
+            (void)snprintf(line, sizeof(line), "queue %s%lu us %lu\n", (bin < (PAD_EVT_HIST_BINS - 1u)) ? "<=" : ">",
+                           (unsigned long)(1uL << ((bin < (PAD_EVT_HIST_BINS - 1u)) ? bin : (bin - 1u))),
+                           (unsigned long)stats.queueHist[bin]);
+            USBUART_PutString(line);
+        }
+    }
+}
 
 int main(void)
 {
+    static uint32 sentCycles[PAD_EVT_PADS];
+    pad_evt_t evt;
+#if (0u != GAME_REPEAT_MS)
+    uint8 pad;
+#endif /* GAME_REPEAT_MS */
+
     CyGlobalIntEnable; /* Enable global interrupts. */
 
     /* Start USBUART */
     USBUART_Start(0, USBUART_5V_OPERATION);
 
-    /* Place your initialization/startup code here (e.g. MyInst_Start()) */
+    // press and release events from the pad interrupts
+    PadEvt_Start();
 
     for (;;)
     {
-        CyDelay(100);
-        /* Send 'a' character continuously */
-        while (USBUART_GetConfiguration() == 0)
-            ;
-        if (Pin_1_Read() == 0)
+        if (0u != USBUART_IsConfigurationChanged())
         {
-            //            USBUART_PutString("left\r\n");
-            USBUART_PutString("right\n");
+            if (0u != USBUART_GetConfiguration())
+            {
+                USBUART_CDC_Init();
+            }
+        }
 
-            //            USBUART_PutChar('l');
-            //            USBUART_PutChar('r');
+        PadEvt_Poll();
+
+        // nobody to tell, drop what happened meanwhile
+        if (USBUART_GetConfiguration() == 0)
+        {
+            while (0u != PadEvt_Get(&evt))
+            {
+            }
+            continue;
         }
-        if (Pin_2_Read() == 0)
+
+        if ((0u != USBUART_DataIsReady()) && ('?' == USBUART_GetChar()))
         {
-            USBUART_PutString("left\n");
-            //            USBUART_PutChar('l');
+            Game_SendStats();
         }
 
-        /* Place your application code here. */
+        // one message per free endpoint, events first, then repeats
+        if (0u == USBUART_CDCIsReady())
+        {
+            continue;
+        }
+        if (0u != PadEvt_Get(&evt))
+        {
+            if (0u != evt.pressed)
+            {
+                USBUART_PutString(padMessage[evt.pad]);
+                sentCycles[evt.pad] = evt.cycles;
+            }
+            continue;
+        }
+        #if (0u != GAME_REPEAT_MS)
+            for (pad = 0u; pad < PAD_EVT_PADS; pad++)
+            {
+                if ((0u != PadEvt_IsPressed(pad)) && ((uint32)(PadEvt_Now() - sentCycles[pad]) >= GAME_REPEAT_CYCLES))
+                {
+                    USBUART_PutString(padMessage[pad]);
+                    sentCycles[pad] += GAME_REPEAT_CYCLES;
+                    break;
+                }
+            }
+        #endif /* GAME_REPEAT_MS */
     }
 }
 
@@ -0,0 +1,217 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#include <string.h>
+#include "project.h"
+#include "pad_evt.h"
+
+#define PAD_EVT_QUEUE_MASK      (PAD_EVT_QUEUE_SIZE - 1u)
+#define PAD_EVT_WINDOW_CYCLES   (PAD_EVT_DEBOUNCE_US * PAD_EVT_CYCLES_PER_US)
+
+typedef struct
+{
+    uint32 startCycles;     // when the debounce window started
+    uint32 lastCycles;      // the last edge seen
+    uint8 pressed;          // the debounced state
+    uint8 locked;           // inside the window
+#if (!PAD_EVT_IRQ_ENABLE)
+    uint8 sampled;          // the level at the last poll
+#endif /* PAD_EVT_IRQ_ENABLE */
+} pad_state_t;
+
+static pad_state_t pads[PAD_EVT_PADS];
+
+static volatile pad_evt_t queue[PAD_EVT_QUEUE_SIZE];
+static volatile uint8 queueHead = 0u;   // free running, the interrupt
+static volatile uint8 queueTail = 0u;   // free running, PadEvt_Get
+
+static pad_evt_stats_t stats;
+
+// 1 while the pad is pressed, the pads pull the pin low
+static uint8 PadEvt_Read(uint8 pad)
+{
+    uint8 level = (0u == pad) ? Pin_1_Read() : Pin_2_Read();
+
+    return (0u == level) ? 1u : 0u;
+}
+
+// Queues an event that happened at cycles and records how long it took.
+// Called from the interrupt, or with it off.
+static void PadEvt_Push(uint8 pad, uint8 pressed, uint32 cycles)
+{
+    volatile pad_evt_t *evt;
+    uint32 us;
+    uint8 bin = 0u;
+
+    if ((uint8)(queueHead - queueTail) >= PAD_EVT_QUEUE_SIZE)
+    {
+        stats.dropped++;
+        return;
+    }
+
+    evt = &queue[queueHead & PAD_EVT_QUEUE_MASK];
+    evt->cycles = cycles;
+    evt->pad = pad;
+    evt->pressed = pressed;
+    queueHead++;
+
+    us = (DWT->CYCCNT - cycles) / PAD_EVT_CYCLES_PER_US;
+    while ((bin < (PAD_EVT_HIST_BINS - 1u)) && (us > (1uL << bin)))
+    {
+        bin++;
+    }
+    stats.queueHist[bin]++;
+    stats.events++;
+    if (us > stats.worstQueueUs)
+    {
+        stats.worstQueueUs = us;
+    }
+}
+
+// One edge of a pad, pressed is the level read after it.
+static void PadEvt_Edge(uint8 pad, uint8 pressed, uint32 cycles)
+{
+    pad_state_t *state = &pads[pad];
+
+    // a bounce, or two edges that came and went before they were seen
+    if ((0u != state->locked) || (pressed == state->pressed))
+    {
+        state->lastCycles = cycles;
+        stats.bounces++;
+        return;
+    }
+
+    state->pressed = pressed;
+    state->startCycles = cycles;
+    state->lastCycles = cycles;
+    state->locked = 1u;
+    PadEvt_Push(pad, pressed, cycles);
+}
+
+#if (PAD_EVT_IRQ_ENABLE)
+
+// Either pad changed. Reading a pin's interrupt status clears it.
+static CY_ISR(PadEvt_Isr)
+{
+    uint32 now = DWT->CYCCNT;
+
+    if (0u != Pin_1_ClearInterrupt())
+    {
+        PadEvt_Edge(0u, PadEvt_Read(0u), now);
+    }
+    if (0u != Pin_2_ClearInterrupt())
+    {
+        PadEvt_Edge(1u, PadEvt_Read(1u), now);
+    }
+}
+
+#endif /* PAD_EVT_IRQ_ENABLE */
+
+void PadEvt_Start(void)
+{
+    uint8 pad;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    queueHead = 0u;
+    queueTail = 0u;
+    (void)memset(&stats, 0, sizeof(stats));
+    for (pad = 0u; pad < PAD_EVT_PADS; pad++)
+    {
+        pads[pad].pressed = PadEvt_Read(pad);
+        pads[pad].locked = 0u;
+        #if (!PAD_EVT_IRQ_ENABLE)
+            pads[pad].sampled = pads[pad].pressed;
+        #endif /* PAD_EVT_IRQ_ENABLE */
+    }
+
+    #if (PAD_EVT_IRQ_ENABLE)
+        (void)Pin_1_ClearInterrupt();
+        (void)Pin_2_ClearInterrupt();
+        isr_Pads_StartEx(&PadEvt_Isr);
+    #endif /* PAD_EVT_IRQ_ENABLE */
+}
+
+void PadEvt_Poll(void)
+{
+    pad_state_t *state;
+    uint32 now;
+    uint8 interruptState;
+    uint8 pressed;
+    uint8 pad;
+
+    for (pad = 0u; pad < PAD_EVT_PADS; pad++)
+    {
+        state = &pads[pad];
+        interruptState = CyEnterCriticalSection();
+        now = DWT->CYCCNT;
+
+        #if (!PAD_EVT_IRQ_ENABLE)
+            pressed = PadEvt_Read(pad);
+            if (pressed != state->sampled)
+            {
+                state->sampled = pressed;
+                PadEvt_Edge(pad, pressed, now);
+            }
+        #endif /* PAD_EVT_IRQ_ENABLE */
+
+        // the window is over, look where the pad settled
+        if ((0u != state->locked) && ((uint32)(now - state->startCycles) >= PAD_EVT_WINDOW_CYCLES))
+        {
+            state->locked = 0u;
+            pressed = PadEvt_Read(pad);
+            if (pressed != state->pressed)
+            {
+                state->pressed = pressed;
+                state->startCycles = now;
+                state->locked = 1u;
+                PadEvt_Push(pad, pressed, state->lastCycles);
+            }
+        }
+        CyExitCriticalSection(interruptState);
+    }
+}
+
+uint8 PadEvt_Get(pad_evt_t *evt)
+{
+    if (queueHead == queueTail)
+    {
+        return 0u;
+    }
+
+    // the interrupt only writes past queueHead, so this slot is ours
+    evt->cycles = queue[queueTail & PAD_EVT_QUEUE_MASK].cycles;
+    evt->pad = queue[queueTail & PAD_EVT_QUEUE_MASK].pad;
+    evt->pressed = queue[queueTail & PAD_EVT_QUEUE_MASK].pressed;
+    queueTail++;
+    return 1u;
+}
+
+uint8 PadEvt_IsPressed(uint8 pad)
+{
+    return pads[pad].pressed;
+}
+
+uint32 PadEvt_Now(void)
+{
+    return DWT->CYCCNT;
+}
+
+void PadEvt_GetStats(pad_evt_stats_t *copy)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    *copy = stats;
+    CyExitCriticalSection(interruptState);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef PAD_EVT_H
+#define PAD_EVT_H
+
+#include "cytypes.h"
+
+/*
+ * Press and release events of the two pads (Pin_1 and Pin_2, active low).
+ * A port interrupt on either edge timestamps the edge with the DWT cycle
+ * counter, which runs freely at the bus clock, as it enters, and debounces
+ * it at once:
+ *
+ *  - an edge that changes the reported state is an event straight away and
+ *    starts a PAD_EVT_DEBOUNCE_US window for that pad
+ *  - edges inside the window are bounces; they are counted and the time of
+ *    the last one is kept
+ *  - once the window is over PadEvt_Poll() reads the pad again; if it has
+ *    settled the other way (e.g. a release that bounced) that is an event,
+ *    timestamped with the last edge, and a new window starts
+ *
+ * So a touch is reported on its first edge, within one interrupt, and a
+ * tap shorter than the window still gives a press and then a release.
+ *
+ * Events go into a power-of-two queue that needs no locking: the interrupt
+ * is the producer, the main loop the consumer through PadEvt_Get(). The
+ * events PadEvt_Poll() adds are written with the interrupt off.
+ *
+ * Every event adds its queue time to a histogram of power-of-two
+ * microsecond bins: from its timestamp to the moment it was queued. For
+ * first-edge events that is the time spent in the interrupt. For settled
+ * events it includes the rest of the window and the wait for
+ * PadEvt_Poll(). The time from the pin to the start of the interrupt is
+ * not in it: no capture timer is placed to take the edge in hardware.
+ *
+ * Needs in TopDesign: Pin_1 and Pin_2 with Interrupt set to Both Edges,
+ * their irq terminals through an OR gate into an Interrupt named isr_Pads.
+ * With PAD_EVT_IRQ_ENABLE set to 0 they are not needed: PadEvt_Poll() then
+ * samples both pads on every call and runs the same debounce, so the
+ * latency is up to one main loop pass.
+ */
+
+#ifndef PAD_EVT_IRQ_ENABLE
+    #define PAD_EVT_IRQ_ENABLE      (1u)
+#endif /* PAD_EVT_IRQ_ENABLE */
+
+#ifndef PAD_EVT_DEBOUNCE_US
+    #define PAD_EVT_DEBOUNCE_US     (5000u)
+#endif /* PAD_EVT_DEBOUNCE_US */
+
+#ifndef PAD_EVT_QUEUE_SIZE
+    #define PAD_EVT_QUEUE_SIZE      (16u)   // power of two
+#endif /* PAD_EVT_QUEUE_SIZE */
+
+#if ((PAD_EVT_QUEUE_SIZE & (PAD_EVT_QUEUE_SIZE - 1u)) != 0u)
+    #error "PAD_EVT_QUEUE_SIZE must be a power of two"
+#endif
+
+#define PAD_EVT_PADS                (2u)    // 0: Pin_1, 1: Pin_2
+#define PAD_EVT_HIST_BINS           (16u)   // bin i: up to 2^i us, the last one more
+#define PAD_EVT_CYCLES_PER_US       (BCLK__BUS_CLK__HZ / 1000000u)
+
+typedef struct
+{
+    uint32 cycles;          // DWT->CYCCNT when the edge was seen
+    uint8 pad;
+    uint8 pressed;          // 1: press, 0: release
+} pad_evt_t;
+
+typedef struct
+{
+    uint32 events;
+    uint32 bounces;         // edges inside a debounce window
+    uint32 dropped;         // events lost because the queue was full
+    uint32 worstQueueUs;    // longest timestamp to queue time
+    uint32 queueHist[PAD_EVT_HIST_BINS];
+} pad_evt_stats_t;
+
+// Starts the cycle counter and the interrupt.
+void PadEvt_Start(void);
+
+// Ends debounce windows and queues what settled in them. Call from the
+// main loop, at least once per PAD_EVT_DEBOUNCE_US to keep settled events
+// timely.
+void PadEvt_Poll(void);
+
+// Takes the oldest event, returns 0 if there is none.
+uint8 PadEvt_Get(pad_evt_t *evt);
+
+// The debounced state of a pad, 1 while pressed.
+uint8 PadEvt_IsPressed(uint8 pad);
+
+// The free running counter the events are timestamped with.
+uint32 PadEvt_Now(void);
+
+void PadEvt_GetStats(pad_evt_stats_t *copy);
+
+#endif /* PAD_EVT_H */
+/* [] END OF FILE */
@@ -0,0 +1,379 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+
+/*
+ * Host test of pad_evt.c on two simulated pads, timed in bus clock cycles
+ * at 24 MHz. Each touch bounces for up to 2.4 ms on the way in and on the
+ * way out; most are held for 10 to 300 ms, one in four is a tap of 1 to
+ * 4 ms, shorter than the debounce window. The pad interrupt runs 12 cycles
+ * to 10 us after an edge, as other interrupts allow, and reads the pin as
+ * it is by then. The main loop calls PadEvt_Poll() every SIM_LOOP_US.
+ *
+ * It checks that every touch gives exactly one press and then one
+ * release, that each press is queued within 1 ms of the first edge, and
+ * that the firmware's queue time histogram counts every event. It prints
+ * the first edge to queue times it saw next to that histogram, which
+ * starts at interrupt entry, and what the old loop, which read the pins
+ * once every 100 ms, would have caught of the same touches.
+ *
+ *   gcc -O2 -I. -I.. pad_evt_test.c ../pad_evt.c -o pad_evt_test
+ *   ./pad_evt_test [touches] [seed]
+ *
+ * Add -DPAD_EVT_IRQ_ENABLE=0 for the polled build without the interrupt.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cytypes.h"
+#include "project.h"
+#include "pad_evt.h"
+
+#define SIM_CPU_MHZ         (BCLK__BUS_CLK__HZ / 1000000u)
+#define SIM_US(us)          ((uint64)(us) * SIM_CPU_MHZ)
+#define SIM_LOOP_US         (50u)
+#define SIM_OLD_POLL_US     (100000u)   // CyDelay(100) in the old loop
+#define SIM_DEFAULT_TOUCHES (2000u)
+#define SIM_MAX_BOUNCES     (6u)
+#define SIM_TARGET_US       (1000u)
+
+typedef struct
+{
+    uint64 at;
+    uint8 pad;
+    uint8 pressed;
+} sim_edge_t;
+
+typedef struct
+{
+    uint64 pressAt;         // first edge in
+    uint64 heldAt;          // last edge in
+    uint64 releaseAt;       // first edge out
+} sim_touch_t;
+
+DWT_Type simDwt;
+CoreDebug_Type simCoreDebug;
+
+static uint64 simState = 1u;
+static uint64 simNow = 0u;
+static uint8 simMasked = 0u;
+static cyisraddress simIsr = NULL;
+static uint8 simLevel[PAD_EVT_PADS] = { 1u, 1u };   // pins idle high
+static uint8 simPending[PAD_EVT_PADS] = { 0u, 0u };
+
+static sim_edge_t *simEdges;
+static uint32 simEdgeCount = 0u;
+static sim_touch_t *simTouches[PAD_EVT_PADS];
+static uint32 simTouchCount[PAD_EVT_PADS] = { 0u, 0u };
+
+static uint32 Sim_Rand(void)
+{
+    // xorshift64*, independent of the firmware
+    simState ^= simState >> 12u;
+    simState ^= simState << 25u;
+    simState ^= simState >> 27u;
+    return (uint32)((simState * 2685821657736338717ull) >> 32u);
+}
+
+static uint32 Sim_Between(uint32 low, uint32 high)
+{
+    return low + (Sim_Rand() % (high - low + 1u));
+}
+
+uint8 Pin_1_Read(void)
+{
+    return simLevel[0];
+}
+
+uint8 Pin_2_Read(void)
+{
+    return simLevel[1];
+}
+
+uint8 Pin_1_ClearInterrupt(void)
+{
+    uint8 pending = simPending[0];
+
+    simPending[0] = 0u;
+    return pending;
+}
+
+uint8 Pin_2_ClearInterrupt(void)
+{
+    uint8 pending = simPending[1];
+
+    simPending[1] = 0u;
+    return pending;
+}
+
+void isr_Pads_StartEx(cyisraddress address)
+{
+    simIsr = address;
+}
+
+uint8 CyEnterCriticalSection(void)
+{
+    uint8 state = simMasked;
+
+    simMasked = 1u;
+    return state;
+}
+
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    simMasked = savedIntrStatus;
+}
+
+static void Sim_SetTime(uint64 at)
+{
+    simNow = at;
+    simDwt.CYCCNT = (uint32)at;
+}
+
+static void Sim_AddEdge(uint64 at, uint8 pad, uint8 pressed)
+{
+    simEdges[simEdgeCount].at = at;
+    simEdges[simEdgeCount].pad = pad;
+    simEdges[simEdgeCount].pressed = pressed;
+    simEdgeCount++;
+}
+
+// Bounces from the current level to pressed, returns the last edge.
+static uint64 Sim_Bounce(uint64 at, uint8 pad, uint8 pressed)
+{
+    uint32 bounces = Sim_Rand() % (SIM_MAX_BOUNCES + 1u);
+    uint32 i;
+
+    // an odd number of edges, ending on the new level
+    for (i = 0u; i < (2u * (bounces / 2u)); i++)
+    {
+        Sim_AddEdge(at, pad, (0u == (i % 2u)) ? pressed : (uint8)(1u - pressed));
+        at += SIM_US(Sim_Between(20u, 400u));
+    }
+    Sim_AddEdge(at, pad, pressed);
+    return at;
+}
+
+static int Sim_EdgeOrder(const void *a, const void *b)
+{
+    const sim_edge_t *x = a;
+    const sim_edge_t *y = b;
+
+    return (x->at < y->at) ? -1 : ((x->at > y->at) ? 1 : 0);
+}
+
+static void Sim_Plan(uint32 touches)
+{
+    sim_touch_t *touch;
+    uint64 at;
+    uint32 i;
+    uint8 pad;
+
+    for (pad = 0u; pad < PAD_EVT_PADS; pad++)
+    {
+        at = SIM_US(Sim_Between(1000u, 50000u));
+        for (i = 0u; i < touches; i++)
+        {
+            touch = &simTouches[pad][i];
+            touch->pressAt = at;
+            touch->heldAt = Sim_Bounce(at, pad, 1u);
+            at = touch->heldAt + SIM_US((0u == (Sim_Rand() % 4u)) ? Sim_Between(1000u, 4000u)
+                                                                  : Sim_Between(10000u, 300000u));
+            touch->releaseAt = at;
+            at = Sim_Bounce(at, pad, 0u) + SIM_US(Sim_Between(20000u, 300000u));
+        }
+        simTouchCount[pad] = touches;
+    }
+    qsort(simEdges, simEdgeCount, sizeof(sim_edge_t), &Sim_EdgeOrder);
+}
+
+static uint8 Sim_Check(uint8 ok, const char *what)
+{
+    printf("%-56s %s\n", what, (0u != ok) ? "ok" : "FAILED");
+    return (0u != ok) ? 0u : 1u;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint32 seenHist[PAD_EVT_HIST_BINS];
+    pad_evt_stats_t stats;
+    pad_evt_t evt;
+    uint32 touches = SIM_DEFAULT_TOUCHES;
+    uint32 next[PAD_EVT_PADS] = { 0u, 0u };     // touch each pad expects next
+    uint8 inTouch[PAD_EVT_PADS] = { 0u, 0u };   // its press has been queued
+    uint32 edge = 0u;
+    uint64 isrAt = 0u;
+    uint8 isrDue = 0u;
+    uint64 pollAt = SIM_US(SIM_LOOP_US);
+    uint64 latency;
+    uint64 worstPress = 0u;
+    uint64 worstRelease = 0u;
+    uint64 totalPress = 0u;
+    uint32 wrong = 0u;
+    uint32 histSum = 0u;
+    uint32 oldSeen = 0u;
+    uint64 oldTotal = 0u;
+    uint64 sample;
+    uint32 bin;
+    uint32 i;
+    uint8 pad;
+    uint8 failed = 0u;
+
+    if (argc > 1)
+    {
+        touches = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        simState = strtoull(argv[2], NULL, 0) | 1u;
+    }
+
+    simEdges = malloc(sizeof(sim_edge_t) * touches * PAD_EVT_PADS * 2u * (SIM_MAX_BOUNCES + 1u));
+    simTouches[0] = malloc(sizeof(sim_touch_t) * touches);
+    simTouches[1] = malloc(sizeof(sim_touch_t) * touches);
+    if ((NULL == simEdges) || (NULL == simTouches[0]) || (NULL == simTouches[1]))
+    {
+        return 1;
+    }
+    Sim_Plan(touches);
+
+    Sim_SetTime(0u);
+    PadEvt_Start();
+    printf("%u touches per pad, debounce %u us, main loop every %u us, %s\n\n",
+           touches, (uint32)PAD_EVT_DEBOUNCE_US, SIM_LOOP_US,
+           (PAD_EVT_IRQ_ENABLE) ? "edge interrupt" : "polled");
+
+    while ((edge < simEdgeCount) || (0u != isrDue) || (next[0] < touches) || (next[1] < touches))
+    {
+        // the next thing to happen: an edge, the interrupt, or a loop pass
+        if ((edge < simEdgeCount) && (simEdges[edge].at <= pollAt) && ((0u == isrDue) || (simEdges[edge].at < isrAt)))
+        {
+            Sim_SetTime(simEdges[edge].at);
+            pad = simEdges[edge].pad;
+            simLevel[pad] = (0u != simEdges[edge].pressed) ? 0u : 1u;
+            edge++;
+            #if (PAD_EVT_IRQ_ENABLE)
+                simPending[pad] = 1u;
+                if (0u == isrDue)
+                {
+                    isrDue = 1u;
+                    isrAt = simNow + 12u + (Sim_Rand() % SIM_US(10u));
+                }
+            #endif /* PAD_EVT_IRQ_ENABLE */
+            continue;
+        }
+        if ((0u != isrDue) && (isrAt <= pollAt))
+        {
+            Sim_SetTime(isrAt);
+            isrDue = 0u;
+            simIsr();
+        }
+        else
+        {
+            Sim_SetTime(pollAt);
+            pollAt += SIM_US(SIM_LOOP_US);
+            PadEvt_Poll();
+            if ((edge >= simEdgeCount) && (simNow > (simEdges[simEdgeCount - 1u].at + SIM_US(100000u))))
+            {
+                break;
+            }
+        }
+
+        // what was queued just now
+        while (0u != PadEvt_Get(&evt))
+        {
+            pad = evt.pad;
+            if ((next[pad] >= simTouchCount[pad]) || (evt.pressed == inTouch[pad]))
+            {
+                wrong++;
+                continue;
+            }
+            if (0u != evt.pressed)
+            {
+                latency = simNow - simTouches[pad][next[pad]].pressAt;
+                totalPress += latency;
+                if (latency > worstPress)
+                {
+                    worstPress = latency;
+                }
+                inTouch[pad] = 1u;
+            }
+            else
+            {
+                latency = simNow - simTouches[pad][next[pad]].releaseAt;
+                if (latency > worstRelease)
+                {
+                    worstRelease = latency;
+                }
+                inTouch[pad] = 0u;
+                next[pad]++;
+            }
+            latency /= SIM_CPU_MHZ;
+            for (bin = 0u; (bin < (PAD_EVT_HIST_BINS - 1u)) && (latency > (1uLL << bin)); bin++)
+            {
+            }
+            seenHist[bin]++;
+        }
+    }
+
+    PadEvt_GetStats(&stats);
+    for (bin = 0u; bin < PAD_EVT_HIST_BINS; bin++)
+    {
+        histSum += stats.queueHist[bin];
+    }
+
+    printf("%u events, %u bounces, %u dropped\n", stats.events, stats.bounces, stats.dropped);
+    printf("press, first edge to queued: mean %.1f us, worst %.1f us\n",
+           (double)totalPress / ((double)touches * PAD_EVT_PADS * SIM_CPU_MHZ),
+           (double)worstPress / SIM_CPU_MHZ);
+    printf("release, first edge to queued: worst %.1f us\n\n", (double)worstRelease / SIM_CPU_MHZ);
+    printf("   up to       edge to queue  firmware queue time\n");
+    for (bin = 0u; bin < PAD_EVT_HIST_BINS; bin++)
+    {
+        if ((0u != seenHist[bin]) || (0u != stats.queueHist[bin]))
+        {
+            printf("  %s%6u us %12u %16u\n", (bin < (PAD_EVT_HIST_BINS - 1u)) ? " " : ">",
+                   (1u << ((bin < (PAD_EVT_HIST_BINS - 1u)) ? bin : (bin - 1u))), seenHist[bin], stats.queueHist[bin]);
+        }
+    }
+
+    // the old loop read each pin once every 100 ms
+    for (pad = 0u; pad < PAD_EVT_PADS; pad++)
+    {
+        for (i = 0u; i < touches; i++)
+        {
+            sample = simTouches[pad][i].heldAt + SIM_US(SIM_OLD_POLL_US)
+                     - (simTouches[pad][i].heldAt % SIM_US(SIM_OLD_POLL_US));
+            if (sample < simTouches[pad][i].releaseAt)
+            {
+                oldSeen++;
+                oldTotal += sample - simTouches[pad][i].pressAt;
+            }
+        }
+    }
+    printf("\nold 100 ms loop: %u of %u touches seen, mean %.1f ms after the first edge\n\n",
+           oldSeen, touches * PAD_EVT_PADS, (0u != oldSeen) ? (double)oldTotal / (oldSeen * 1000.0 * SIM_CPU_MHZ) : 0.0);
+
+    failed |= Sim_Check((0u == wrong) && (next[0] == touches) && (next[1] == touches) && (0u == stats.dropped),
+                        "every touch gives one press, then one release");
+    failed |= Sim_Check(worstPress < SIM_US(SIM_TARGET_US), "every press queued within 1 ms of its first edge");
+    failed |= Sim_Check((histSum == stats.events) && (stats.events == (2u * touches * PAD_EVT_PADS)),
+                        "the queue time histogram counts every event");
+
+    free(simEdges);
+    free(simTouches[0]);
+    free(simTouches[1]);
+    return (0u != failed) ? 1 : 0;
+}
+
+/* [] END OF FILE */
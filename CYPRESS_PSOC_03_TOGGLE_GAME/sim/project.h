@@ -0,0 +1,58 @@
+/* ========================================
+ *
+ * Copyright YOUR COMPANY, THE YEAR
+ * All Rights Reserved
+ * UNPUBLISHED, LICENSED SOFTWARE.
+ *
+ * CONFIDENTIAL AND PROPRIETARY INFORMATION
+ * WHICH IS THE PROPERTY OF your company.
+ *
+ * ========================================
+*/
+#ifndef PROJECT_H
+#define PROJECT_H
+
+/*
+ * Host stand-in for Generated_Source/PSoC5/project.h, with what pad_evt.c
+ * uses: the two pad pins, their interrupt, critical sections and the DWT
+ * cycle counter. The test that links it provides the model behind them.
+ */
+
+#include <string.h>     // CyLib.h includes it, so project.h users get NULL
+#include "cytypes.h"
+
+#define BCLK__BUS_CLK__HZ   (24000000u)
+
+// Pins, with their Interrupt set to Both Edges
+uint8 Pin_1_Read(void);
+uint8 Pin_2_Read(void);
+uint8 Pin_1_ClearInterrupt(void);
+uint8 Pin_2_ClearInterrupt(void);
+void isr_Pads_StartEx(cyisraddress address);
+
+// CyLib critical sections
+uint8 CyEnterCriticalSection(void);
+void CyExitCriticalSection(uint8 savedIntrStatus);
+
+// core_cm3.h cycle counter
+typedef struct
+{
+    volatile uint32 CTRL;
+    volatile uint32 CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32 DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type simDwt;
+extern CoreDebug_Type simCoreDebug;
+
+#define DWT                             (&simDwt)
+#define CoreDebug                       (&simCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk          (1uL)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1uL << 24)
+
+#endif /* PROJECT_H */
+/* [] END OF FILE */